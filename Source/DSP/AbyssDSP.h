@@ -0,0 +1,33 @@
+#pragma once
+
+//==============================================================================
+// AbyssDSP: the plugin's signal-processing core, independent of the
+// AudioProcessor wrapper. Depends only on juce_core / juce_audio_basics /
+// juce_dsp, so benchmarks, tests and offline tools can link it headless.
+// Per-sample code stays inline in the headers; preparation and worker-thread
+// code lives in the library's translation units.
+//==============================================================================
+
+#include "PickupIRConvolver.h"
+#include "FeedbackSuppressor.h"
+#include "ViolinInputConditioner.h"
+#include "EnvelopeFollower.h"
+#include "PitchTracker.h"
+#include "SympatheticResonator.h"
+#include "TapeSaturator.h"
+#include "InputDiffuser.h"
+#include "GrainShifter.h"
+#include "AbyssFDNReverb.h"
+#include "DattorroPlate.h"
+#include "TailConvolver.h"
+#include "HybridTailReverb.h"
+#include "SpectralFreeze.h"
+#include "DegradeOversampler.h"
+#include "VanishingDelay.h"
+#include "SmoothedParameters.h"
+#include "ReverbEngines.h"
+#include "RealtimeCheck.h"
+#include "StateProbe.h"
+#include "StageProfiler.h"
+#include "DeadlineMonitor.h"
+#include "TraceRecorder.h"
@@ -0,0 +1,335 @@
+#pragma once
+
+#include "GrainShifter.h"
+#include "TapeSaturator.h"
+#include "StateProbe.h"
+
+//==============================================================================
+// AbyssFDNReverb: 8-line FDN with frequency-dependent damping & modulation
+// Enhanced violin version with 3-band RT60 damping and detune
+//==============================================================================
+class AbyssFDNReverb
+{
+public:
+    static constexpr int NUM_LINES = 8;
+
+    void prepare(double sampleRate, int samplesPerBlock)
+    {
+        sr = sampleRate;
+
+        // Prime-based delay lengths for deep space (optimized for violin)
+        const int baseLengths[NUM_LINES] = {
+            1557, 1617, 1491, 1422, 1277, 1356, 1188, 1116
+        };
+
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            size_t len = static_cast<size_t>(baseLengths[i] * sr / 44100.0);
+            delayLines[i].resize(len, 0.0f);
+            writePos[i] = 0;
+            lowState[i] = 0.0f;
+            highState[i] = 0.0f;
+        }
+
+        // LFO phase initialization (spread for modulation)
+        for (int i = 0; i < NUM_LINES; ++i)
+            lfoPhase[i] = static_cast<float>(i) / NUM_LINES;
+
+        // Prewarped shelf crossovers (shared by all lines)
+        tanLow = std::tan(juce::MathConstants<float>::pi * LOW_CROSSOVER / static_cast<float>(sr));
+        tanHigh = std::tan(juce::MathConstants<float>::pi * HIGH_CROSSOVER / static_cast<float>(sr));
+        dampingDirty = true;
+        controlCountdown = 0;
+        modScale = frozen ? 0.0f : 1.0f;
+        modScaleStep = 1.0f / static_cast<float>(sr * MOD_GLIDE_SECONDS);
+
+        for (auto& shifter : shifters)
+            shifter.prepare(sr);
+        shimmerRunning = false;
+    }
+
+    // Infinite hold: unity feedback, no damping, input ignored
+    // Engaging first glides the modulated reads onto the fixed taps the frozen
+    // kernel uses (input already muted); releasing glides the modulation back in
+    void setFrozen(bool shouldFreeze)
+    {
+        frozen = shouldFreeze;
+    }
+
+    // Soft-clip the recirculating signal (input injection stays clean)
+    void setSaturation(bool shouldSaturate)
+    {
+        if (shouldSaturate && ! saturate)
+            for (auto& s : saturators)
+                s.reset();
+        saturate = shouldSaturate;
+    }
+
+    // Blend pitch-shifted feedback into the first SHIMMER_LINES lines
+    void setShimmer(float amount, float ratio)
+    {
+        shimmerAmount = amount;
+        for (auto& shifter : shifters)
+            shifter.setRatio(ratio);
+    }
+
+    // dampHigh/dampLow shorten the high/low band RT60 relative to decayTime (mid band)
+    void setParameters(float decayTime, float dampHigh, float dampLow,
+                       float modDepth, float modRate, float detuneAmount)
+    {
+        if (decayTime != decay || dampHigh != dampHighCoeff || dampLow != dampLowCoeff)
+            dampingDirty = true;
+
+        decay = decayTime;
+        dampHighCoeff = dampHigh;
+        dampLowCoeff = dampLow;
+        this->modDepth = modDepth;
+        this->modRate = modRate;
+        this->detuneAmount = detuneAmount;
+    }
+
+    float process(float input)
+    {
+        if (frozen)
+        {
+            if (modScale <= 0.0f)
+                return processFrozen();
+            modScale = juce::jmax(0.0f, modScale - modScaleStep);
+        }
+        else if (modScale < 1.0f)
+        {
+            modScale = juce::jmin(1.0f, modScale + modScaleStep);
+        }
+
+        // Band gains are redesigned at control rate, only after a parameter change
+        if (--controlCountdown <= 0)
+        {
+            controlCountdown = CONTROL_INTERVAL;
+            if (dampingDirty)
+                updateDamping();
+        }
+
+        float outputs[NUM_LINES];
+
+        // Read from each delay line with modulation
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            size_t len = delayLines[i].size();
+
+            // LFO for delay time modulation
+            lfoPhase[i] += modRate * (1.0f + detuneAmount * static_cast<float>(i) * 0.1f)
+                           / static_cast<float>(sr);
+            if (lfoPhase[i] >= 1.0f) lfoPhase[i] -= 1.0f;
+            float lfo = std::sin(2.0f * juce::MathConstants<float>::pi * lfoPhase[i]);
+            float modSamples = lfo * modDepth * modScale * (static_cast<float>(sr) / 1000.0f);
+
+            // Linear interpolation readout
+            float readPosF = static_cast<float>(writePos[i]) - static_cast<float>(len) + modSamples;
+            while (readPosF < 0.0f) readPosF += static_cast<float>(len);
+            size_t readIdx0 = static_cast<size_t>(readPosF) % len;
+            size_t readIdx1 = (readIdx0 + 1) % len;
+            float frac = readPosF - std::floor(readPosF);
+
+            outputs[i] = delayLines[i][readIdx0] * (1.0f - frac)
+                       + delayLines[i][readIdx1] * frac;
+        }
+
+        // Hadamard feedback matrix (normalized)
+        float feedback[NUM_LINES];
+        std::copy(outputs, outputs + NUM_LINES, feedback);
+        hadamard(feedback);
+
+        // 3-band absorption: first-order low shelf -> high shelf per line, mid gain folded in.
+        // SoA across lines so the loop vectorizes; no per-sample coefficient math.
+        const float injected = frozen ? 0.0f : input / static_cast<float>(NUM_LINES);
+        float damped[NUM_LINES];
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            float lowOut = lowB0[i] * feedback[i] + lowState[i];
+            lowState[i] = lowB1[i] * feedback[i] - lowA1[i] * lowOut;
+
+            float highOut = highB0[i] * lowOut + highState[i];
+            highState[i] = highB1[i] * lowOut - highA1[i] * highOut;
+
+            damped[i] = highOut;
+        }
+
+        // Shimmer: each trip round the loop shifts these lines up again
+        if (shimmerAmount > 1.0e-4f)
+        {
+            if (! shimmerRunning)
+            {
+                for (auto& shifter : shifters)
+                    shifter.reset();
+                shimmerRunning = true;
+            }
+            for (int i = 0; i < SHIMMER_LINES; ++i)
+                damped[i] += shimmerAmount * (shifters[i].process(damped[i]) - damped[i]);
+        }
+        else
+        {
+            shimmerRunning = false;
+        }
+
+        if (saturate)
+            for (int i = 0; i < NUM_LINES; ++i)
+                damped[i] = saturators[i].process(damped[i]);
+
+        for (int i = 0; i < NUM_LINES; ++i)
+            damped[i] += injected;
+
+        float outputMix = 0.0f;
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            delayLines[i][static_cast<size_t>(writePos[i])] = damped[i];
+            if (++writePos[i] == static_cast<int>(delayLines[i].size()))
+                writePos[i] = 0;
+
+            outputMix += outputs[i];
+        }
+
+        return outputMix * HADAMARD_SCALE;
+    }
+
+    // Frozen kernel: read the full-length tap, mix, write back. The normalized
+    // Hadamard is orthogonal, so the loop holds its energy indefinitely.
+    float processFrozen()
+    {
+        float lines[NUM_LINES];
+        float outputMix = 0.0f;
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            lines[i] = delayLines[i][static_cast<size_t>(writePos[i])];
+            outputMix += lines[i];
+        }
+
+        hadamard(lines);
+
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            delayLines[i][static_cast<size_t>(writePos[i])] = lines[i];
+            if (++writePos[i] == static_cast<int>(delayLines[i].size()))
+                writePos[i] = 0;
+        }
+
+        return outputMix * HADAMARD_SCALE;
+    }
+
+    void clear()
+    {
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            std::fill(delayLines[i].begin(), delayLines[i].end(), 0.0f);
+            lowState[i] = 0.0f;
+            highState[i] = 0.0f;
+            saturators[i].reset();
+        }
+    }
+
+    void probeState(StateProbe& probe) const
+    {
+        for (const auto& line : delayLines)
+            probe.visit("delayLine", line);
+        probe.visit("lowState", lowState);
+        probe.visit("highState", highState);
+        for (const auto& s : saturators)
+            s.probeState(probe);
+        for (const auto& s : shifters)
+            s.probeState(probe);
+    }
+
+private:
+    static constexpr int CONTROL_INTERVAL = 32;
+    static constexpr float LOW_CROSSOVER = 200.0f;    // Violin open G (196 Hz) and below
+    static constexpr float HIGH_CROSSOVER = 5000.0f;  // Bow noise / "air" region
+    static constexpr float MIN_RT60_RATIO = 0.05f;
+    static constexpr double MOD_GLIDE_SECONDS = 0.1;  // 3 ms max depth -> at most a 3 % pitch glide
+
+    // Per-line band gains from low/mid/high RT60 targets, g = 10^(-3 * delay / RT60),
+    // realised as a first-order low shelf (gLow/gMid) and high shelf (gHigh/gMid, x gMid)
+    void updateDamping()
+    {
+        dampingDirty = false;
+
+        const float rtMid = juce::jmax(0.05f, decay);
+        const float rtLow = rtMid * juce::jmax(MIN_RT60_RATIO, 1.0f - dampLowCoeff);
+        const float rtHigh = rtMid * juce::jmax(MIN_RT60_RATIO, 1.0f - dampHighCoeff);
+
+        for (int i = 0; i < NUM_LINES; ++i)
+        {
+            const float delaySeconds = static_cast<float>(delayLines[i].size()) / static_cast<float>(sr);
+            const float gainLow = std::pow(10.0f, -3.0f * delaySeconds / rtLow);
+            const float gainMid = std::pow(10.0f, -3.0f * delaySeconds / rtMid);
+            const float gainHigh = std::pow(10.0f, -3.0f * delaySeconds / rtHigh);
+
+            designLowShelf(gainLow / gainMid, tanLow, lowB0[i], lowB1[i], lowA1[i]);
+
+            // High shelf with HF gain G == G * low shelf with DC gain 1/G
+            const float highRatio = gainHigh / gainMid;
+            designLowShelf(1.0f / highRatio, tanHigh, highB0[i], highB1[i], highA1[i]);
+            highB0[i] *= highRatio * gainMid;
+            highB1[i] *= highRatio * gainMid;
+        }
+    }
+
+    // Bilinear first-order low shelf: DC gain 'gain', HF gain 1, geometric midpoint at the crossover
+    static void designLowShelf(float gain, float t, float& b0, float& b1, float& a1)
+    {
+        const float root = std::sqrt(gain);
+        const float a0 = 1.0f + t / root;
+        b0 = (1.0f + t * root) / a0;
+        b1 = (t * root - 1.0f) / a0;
+        a1 = (t / root - 1.0f) / a0;
+    }
+
+    static constexpr float HADAMARD_SCALE = 0.35355339f; // 1 / sqrt(NUM_LINES)
+    static_assert(NUM_LINES == 8, "HADAMARD_SCALE assumes 8 lines");
+
+    // In-place fast Walsh-Hadamard transform: sign pattern (-1)^popcount(i&j), normalized
+    static void hadamard(float* x)
+    {
+        for (int h = 1; h < NUM_LINES; h <<= 1)
+            for (int i = 0; i < NUM_LINES; i += h << 1)
+                for (int j = i; j < i + h; ++j)
+                {
+                    float a = x[j], b = x[j + h];
+                    x[j] = a + b;
+                    x[j + h] = a - b;
+                }
+
+        for (int i = 0; i < NUM_LINES; ++i)
+            x[i] *= HADAMARD_SCALE;
+    }
+
+    double sr = 44100.0;
+    std::vector<float> delayLines[NUM_LINES];
+    int writePos[NUM_LINES] = {};
+    float lfoPhase[NUM_LINES] = {};
+
+    // 3-band damping: per-line shelf coefficients and crossover state (SoA)
+    alignas(16) float lowB0[NUM_LINES] = {}, lowB1[NUM_LINES] = {}, lowA1[NUM_LINES] = {};
+    alignas(16) float highB0[NUM_LINES] = {}, highB1[NUM_LINES] = {}, highA1[NUM_LINES] = {};
+    alignas(16) float lowState[NUM_LINES] = {};
+    alignas(16) float highState[NUM_LINES] = {};
+    float tanLow = 0.018f;
+    float tanHigh = 0.25f;
+    bool dampingDirty = true;
+    int controlCountdown = 0;
+
+    float decay = 6.0f;
+    float dampHighCoeff = 0.7f;
+    float dampLowCoeff = 0.3f;
+    float modDepth = 0.5f;
+    float modRate = 0.3f;
+    float detuneAmount = 0.0f;
+    bool frozen = false;
+    float modScale = 1.0f, modScaleStep = 0.001f;    // Modulation depth scale, 0 while frozen
+
+    TapeSaturator saturators[NUM_LINES];
+    bool saturate = false;
+
+    static constexpr int SHIMMER_LINES = 2;
+    GrainShifter shifters[SHIMMER_LINES];
+    float shimmerAmount = 0.0f;
+    bool shimmerRunning = false;
+};
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "StateProbe.h"
+
+#include <vector>
+
+//==============================================================================
+// DattorroPlate: "Eco" plate reverb (Dattorro 1997 topology)
+// Four input allpasses into a two-half figure-eight tank with modulated
+// allpasses; stereo output from fixed multi-taps. Roughly a fifth of the
+// stereo FDN's work per sample. Same parameter set as AbyssFDNReverb.
+//==============================================================================
+class DattorroPlate
+{
+public:
+    void prepare(double sampleRate)
+    {
+        sr = sampleRate;
+        const double scale = sr / REFERENCE_RATE;
+        auto scaled = [scale](int length) { return juce::jmax(1, static_cast<int>(length * scale + 0.5)); };
+
+        const int maxExcursion = static_cast<int>(sr * MAX_MOD_MS / 1000.0) + 2;
+
+        for (int i = 0; i < 4; ++i)
+            inputDiffusers[i].prepare(scaled(INPUT_DIFFUSER_LENGTHS[i]), 0);
+
+        for (int half = 0; half < 2; ++half)
+        {
+            Tank& t = tank[half];
+            t.modAllpass.prepare(scaled(TANK_LENGTHS[half][0]), maxExcursion);
+            t.delay1.prepare(scaled(TANK_LENGTHS[half][1]), 0);
+            t.allpass.prepare(scaled(TANK_LENGTHS[half][2]), 0);
+            t.delay2.prepare(scaled(TANK_LENGTHS[half][3]), 0);
+
+            // Quadrature LFO, halves a quarter cycle apart
+            t.lfoSin = static_cast<float>(half);
+            t.lfoCos = 1.0f - static_cast<float>(half);
+        }
+
+        for (int i = 0; i < NUM_OUTPUT_TAPS; ++i)
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                const auto& tap = OUTPUT_TAPS[ch][i];
+                const Tank& t = tank[tap.half];
+                tapLines[ch][i] = tap.node == Delay1 ? &t.delay1
+                                : tap.node == Allpass2 ? static_cast<const Line*>(&t.allpass) : &t.delay2;
+                tapOffsets[ch][i] = scaled(tap.offset);
+            }
+
+        // Fixed input bandwidth (~10 kHz) and low-band crossover (200 Hz)
+        bandwidthCoeff = std::exp(-2.0f * juce::MathConstants<float>::pi * 10000.0f / static_cast<float>(sr));
+        lowCoeff = 1.0f - std::exp(-2.0f * juce::MathConstants<float>::pi * 200.0f / static_cast<float>(sr));
+
+        // Mean spacing between decay multipliers: a quarter of the tank round trip
+        int loopLength = 0;
+        for (auto& half : TANK_LENGTHS)
+            for (int length : half)
+                loopLength += scaled(length);
+        decayInterval = static_cast<float>(loopLength) / (4.0f * static_cast<float>(sr));
+
+        clear();
+    }
+
+    void setFrozen(bool shouldFreeze) { frozen = shouldFreeze; }
+
+    void setParameters(float decayTime, float dampHigh, float dampLow,
+                       float modDepth, float modRate, float detuneAmount)
+    {
+        if (decayTime != decay)
+        {
+            decay = decayTime;
+            decayGain = std::pow(10.0f, -3.0f * decayInterval / juce::jmax(0.05f, decay));
+        }
+        damping = dampHigh * MAX_DAMPING;
+        lowCut = dampLow * MAX_LOW_CUT;
+        excursion = juce::jmin(modDepth, MAX_MOD_MS) * static_cast<float>(sr) / 1000.0f;
+
+        // Rotation per sample (small-angle: sin w ~ w, cos w ~ 1 - w^2/2)
+        const float twoPiOverSr = 2.0f * juce::MathConstants<float>::pi / static_cast<float>(sr);
+        lfoRotation[0] = modRate * twoPiOverSr;
+        lfoRotation[1] = modRate * (1.0f + detuneAmount * 0.1f) * twoPiOverSr;
+    }
+
+    void process(float inputL, float inputR, float& outputL, float& outputR)
+    {
+        // Frozen: lossless tank, input ignored
+        const float input = frozen ? 0.0f : 0.5f * (inputL + inputR);
+        const float gain = frozen ? 1.0f : decayGain;
+        const float damp = frozen ? 0.0f : damping;
+        const float cut = frozen ? 0.0f : lowCut;
+        const float depth = frozen ? 0.0f : excursion;   // Integer reads: no interpolation loss
+
+        bandwidthState = input + bandwidthCoeff * (bandwidthState - input);
+        float diffused = bandwidthState;
+        diffused = inputDiffusers[0].process(diffused, INPUT_DIFFUSION_1);
+        diffused = inputDiffusers[1].process(diffused, INPUT_DIFFUSION_1);
+        diffused = inputDiffusers[2].process(diffused, INPUT_DIFFUSION_2);
+        diffused = inputDiffusers[3].process(diffused, INPUT_DIFFUSION_2);
+
+        // Figure-eight: each half is fed by the other half's last delay
+        const float crossFeed[2] = { tank[1].delay2.read(0.0f), tank[0].delay2.read(0.0f) };
+
+        for (int half = 0; half < 2; ++half)
+        {
+            Tank& t = tank[half];
+
+            // Rotate the LFO phasor; first-order renormalisation keeps it on the unit circle
+            const float w = lfoRotation[half];
+            const float c = 1.0f - 0.5f * w * w;
+            const float newSin = t.lfoSin * c + t.lfoCos * w;
+            const float newCos = t.lfoCos * c - t.lfoSin * w;
+            const float norm = 1.5f - 0.5f * (newSin * newSin + newCos * newCos);
+            t.lfoSin = newSin * norm;
+            t.lfoCos = newCos * norm;
+            const float mod = depth * t.lfoSin;
+
+            float x = diffused + gain * crossFeed[half];
+            x = t.modAllpass.process(x, -DECAY_DIFFUSION_1, mod);
+            t.delay1.write(x);
+
+            // High damping (one-pole LP) and low cut (subtract part of the low band)
+            float y = t.delay1.read(0.0f);
+            t.dampState = y + damp * (t.dampState - y);
+            y = t.dampState;
+            t.lowState += lowCoeff * (y - t.lowState);
+            y = (y - cut * t.lowState) * gain;
+
+            y = t.allpass.process(y, DECAY_DIFFUSION_2);
+            t.delay2.write(y);
+        }
+
+        float out[2];
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            float sum = 0.0f;
+            for (int i = 0; i < NUM_OUTPUT_TAPS; ++i)
+                sum += OUTPUT_TAPS[ch][i].sign * tapLines[ch][i]->tap(tapOffsets[ch][i]);
+            out[ch] = sum * OUTPUT_GAIN;
+        }
+        outputL = out[0];
+        outputR = out[1];
+
+        for (auto& d : inputDiffusers) d.advance();
+        for (auto& t : tank)
+        {
+            t.modAllpass.advance();
+            t.delay1.advance();
+            t.allpass.advance();
+            t.delay2.advance();
+        }
+    }
+
+    void clear()
+    {
+        for (auto& d : inputDiffusers) d.clear();
+        for (auto& t : tank)
+        {
+            t.modAllpass.clear();
+            t.delay1.clear();
+            t.allpass.clear();
+            t.delay2.clear();
+            t.dampState = t.lowState = 0.0f;
+        }
+        bandwidthState = 0.0f;
+    }
+
+    void probeState(StateProbe& probe) const
+    {
+        for (const auto& d : inputDiffusers)
+            probe.visit("inputDiffuser", d.buffer);
+        for (const auto& t : tank)
+        {
+            probe.visit("tankModAllpass", t.modAllpass.buffer);
+            probe.visit("tankDelay1", t.delay1.buffer);
+            probe.visit("tankAllpass", t.allpass.buffer);
+            probe.visit("tankDelay2", t.delay2.buffer);
+            probe.visit("tankDampState", t.dampState);
+            probe.visit("tankLowState", t.lowState);
+        }
+        probe.visit("bandwidthState", bandwidthState);
+    }
+
+private:
+    static constexpr double REFERENCE_RATE = 29761.0;   // Dattorro's published rate
+    static constexpr float INPUT_DIFFUSION_1 = 0.75f;
+    static constexpr float INPUT_DIFFUSION_2 = 0.625f;
+    static constexpr float DECAY_DIFFUSION_1 = 0.7f;
+    static constexpr float DECAY_DIFFUSION_2 = 0.5f;
+    static constexpr float MAX_DAMPING = 0.8f;
+    static constexpr float MAX_LOW_CUT = 0.7f;
+    static constexpr float MAX_MOD_MS = 2.0f;
+    static constexpr float OUTPUT_GAIN = 0.6f;
+    static constexpr int NUM_OUTPUT_TAPS = 7;
+
+    static constexpr int INPUT_DIFFUSER_LENGTHS[4] = { 142, 107, 379, 277 };
+    // Per half: modulated allpass, delay 1, allpass, delay 2
+    static constexpr int TANK_LENGTHS[2][4] = { { 672, 4453, 1800, 3720 }, { 908, 4217, 2656, 3163 } };
+
+    // Delay line on a power-of-two ring; write() then advance() once per sample
+    struct Line
+    {
+        void prepare(int length, int extra)
+        {
+            delay = length;
+            const int size = juce::nextPowerOfTwo(length + extra + 2);
+            buffer.assign(static_cast<size_t>(size), 0.0f);
+            mask = size - 1;
+            writePos = 0;
+        }
+
+        // Output of the full-length line, modulated by 'offset' samples
+        float read(float offset) const
+        {
+            const float readPos = static_cast<float>(writePos - delay + (mask + 1)) - offset;
+            const int index = static_cast<int>(readPos);
+            const float frac = readPos - static_cast<float>(index);
+            const float a = buffer[static_cast<size_t>(index & mask)];
+            const float b = buffer[static_cast<size_t>((index + 1) & mask)];
+            return a + frac * (b - a);
+        }
+
+        // Sample written 'offset' samples ago (output taps)
+        float tap(int offset) const { return buffer[static_cast<size_t>((writePos - offset) & mask)]; }
+
+        void write(float value) { buffer[static_cast<size_t>(writePos)] = value; }
+        void advance() { writePos = (writePos + 1) & mask; }
+        void clear() { std::fill(buffer.begin(), buffer.end(), 0.0f); }
+
+        std::vector<float> buffer;
+        int delay = 1, mask = 0, writePos = 0;
+    };
+
+    // Schroeder allpass on a Line; 'offset' modulates the read
+    struct Allpass : Line
+    {
+        float process(float input, float g, float offset = 0.0f)
+        {
+            const float delayed = read(offset);
+            const float v = input + g * delayed;
+            write(v);
+            return delayed - g * v;
+        }
+    };
+
+    struct Tank
+    {
+        Allpass modAllpass, allpass;
+        Line delay1, delay2;
+        float dampState = 0.0f, lowState = 0.0f;
+        float lfoSin = 0.0f, lfoCos = 1.0f;
+    };
+
+    enum Node { Delay1, Allpass2, Delay2 };
+    struct OutputTap { int half; Node node; int offset; float sign; };
+
+    // Dattorro's output taps (left, right) at the reference rate
+    static constexpr OutputTap OUTPUT_TAPS[2][NUM_OUTPUT_TAPS] = {
+        { { 1, Delay1, 266, 1.0f }, { 1, Delay1, 2974, 1.0f }, { 1, Allpass2, 1913, -1.0f }, { 1, Delay2, 1996, 1.0f },
+          { 0, Delay1, 1990, -1.0f }, { 0, Allpass2, 187, -1.0f }, { 0, Delay2, 1066, -1.0f } },
+        { { 0, Delay1, 353, 1.0f }, { 0, Delay1, 3627, 1.0f }, { 0, Allpass2, 1228, -1.0f }, { 0, Delay2, 2673, 1.0f },
+          { 1, Delay1, 2111, -1.0f }, { 1, Allpass2, 335, -1.0f }, { 1, Delay2, 121, -1.0f } }
+    };
+
+    double sr = 44100.0;
+    Allpass inputDiffusers[4];
+    Tank tank[2];
+    const Line* tapLines[2][NUM_OUTPUT_TAPS] = {};
+    int tapOffsets[2][NUM_OUTPUT_TAPS] = {};
+
+    float bandwidthCoeff = 0.3f, bandwidthState = 0.0f;
+    float lowCoeff = 0.03f;
+    float decayInterval = 0.18f;
+
+    float decay = -1.0f, decayGain = 0.5f;
+    float damping = 0.0f, lowCut = 0.0f;
+    float excursion = 0.0f;
+    float lfoRotation[2] = {};
+    bool frozen = false;
+};
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+//==============================================================================
+// DeadlineMonitor: processBlock wall time against the buffer's real-time
+// duration. Each block's load (elapsed / budget) goes into a histogram of
+// 5 % bins; loads above the near-miss threshold (70 % by default) and above
+// 100 % are counted, and the most recent of those are kept as events with
+// the caller's context bits (which features were running), so an overload
+// can be traced to the settings that caused it.
+//
+// The audio thread is the only writer. Counters are relaxed atomics; events
+// sit in a fixed ring guarded by per-slot sequence numbers, so readers on
+// any thread retry instead of locking and never see a half-written event.
+//==============================================================================
+class DeadlineMonitor
+{
+public:
+    static constexpr int NUM_BINS = 41;            // 0-5 %, 5-10 %, ... 195-200 %, then >= 200 %
+    static constexpr float BIN_WIDTH = 0.05f;
+    static constexpr int NUM_EVENTS = 32;
+
+    struct Event
+    {
+        double time = 0.0;          // Seconds since the monitor was created
+        float load = 0.0f;          // Elapsed / budget
+        int numSamples = 0;
+        double sampleRate = 0.0;
+        uint32_t context = 0;       // Caller-defined feature bits
+    };
+
+    struct Summary
+    {
+        uint32_t bins[NUM_BINS] {};
+        uint64_t blocks = 0;
+        uint64_t nearMisses = 0;    // Above the threshold, within budget
+        uint64_t misses = 0;        // Over budget
+        float worstLoad = 0.0f, lastLoad = 0.0f;
+        float nearMissThreshold = 0.0f;
+
+        // Load below which the given fraction of blocks fell (upper bin edge)
+        float getLoadPercentile(double fraction) const
+        {
+            uint64_t total = 0;
+            for (auto b : bins)
+                total += b;
+            if (total == 0)
+                return 0.0f;
+
+            const double target = fraction * static_cast<double>(total);
+            uint64_t running = 0;
+            for (int i = 0; i < NUM_BINS; ++i)
+            {
+                running += bins[i];
+                if (static_cast<double>(running) >= target)
+                    return static_cast<float>(i + 1) * BIN_WIDTH;
+            }
+            return static_cast<float>(NUM_BINS) * BIN_WIDTH;
+        }
+    };
+
+    void setNearMissThreshold(float load) noexcept { nearMissThreshold.store(load, std::memory_order_relaxed); }
+
+    //==============================================================================
+    // Audio thread: times one processBlock from construction to destruction
+    class Scope
+    {
+    public:
+        Scope(DeadlineMonitor& m, int numSamples, double sampleRate) noexcept
+            : monitor(m), samples(numSamples), rate(sampleRate), start(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~Scope()
+        {
+            if (samples <= 0 || rate <= 0.0)
+                return;
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            monitor.record(start, static_cast<float>(elapsed.count() * rate / samples), samples, rate, context);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        // Features active in this block, reported with near-miss / miss events
+        void setContext(uint32_t bits) noexcept { context = bits; }
+
+    private:
+        DeadlineMonitor& monitor;
+        const int samples;
+        const double rate;
+        uint32_t context = 0;
+        const std::chrono::steady_clock::time_point start;
+    };
+
+    //==============================================================================
+    // Any thread
+    Summary getSummary() const noexcept
+    {
+        Summary s;
+        for (int i = 0; i < NUM_BINS; ++i)
+            s.bins[i] = bins[i].load(std::memory_order_relaxed);
+        s.blocks = blocks.load(std::memory_order_relaxed);
+        s.nearMisses = nearMisses.load(std::memory_order_relaxed);
+        s.misses = misses.load(std::memory_order_relaxed);
+        s.worstLoad = worstLoad.load(std::memory_order_relaxed);
+        s.lastLoad = lastLoad.load(std::memory_order_relaxed);
+        s.nearMissThreshold = nearMissThreshold.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // Copies up to NUM_EVENTS most recent near-miss / miss events, oldest first; returns the count
+    int getRecentEvents(Event* destination) const noexcept
+    {
+        const uint64_t written = eventsWritten.load(std::memory_order_acquire);
+        const uint64_t first = written > NUM_EVENTS ? written - NUM_EVENTS : 0;
+        int count = 0;
+
+        for (uint64_t index = first; index < written; ++index)
+        {
+            const auto& slot = events[index % NUM_EVENTS];
+            for (int attempt = 0; attempt < 4; ++attempt)
+            {
+                const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+                if (before & 1u)
+                    continue;
+                Event e { slot.time.load(std::memory_order_relaxed), slot.load.load(std::memory_order_relaxed),
+                          slot.numSamples.load(std::memory_order_relaxed), slot.sampleRate.load(std::memory_order_relaxed),
+                          slot.context.load(std::memory_order_relaxed) };
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == before)
+                {
+                    destination[count++] = e;
+                    break;
+                }
+            }
+        }
+        return count;
+    }
+
+    // Message thread; blocks in flight may still land in the cleared counters
+    // Old events stay in their slots but are no longer reachable from eventsWritten
+    void reset() noexcept
+    {
+        for (auto& b : bins)
+            b.store(0, std::memory_order_relaxed);
+        blocks.store(0, std::memory_order_relaxed);
+        nearMisses.store(0, std::memory_order_relaxed);
+        misses.store(0, std::memory_order_relaxed);
+        worstLoad.store(0.0f, std::memory_order_relaxed);
+        lastLoad.store(0.0f, std::memory_order_relaxed);
+        eventsWritten.store(0, std::memory_order_release);
+    }
+
+private:
+    void record(std::chrono::steady_clock::time_point start, float load, int numSamples, double sampleRate,
+                uint32_t context) noexcept
+    {
+        const int bin = load < static_cast<float>(NUM_BINS - 1) * BIN_WIDTH ? static_cast<int>(load / BIN_WIDTH) : NUM_BINS - 1;
+        bins[bin].fetch_add(1, std::memory_order_relaxed);
+        blocks.fetch_add(1, std::memory_order_relaxed);
+        lastLoad.store(load, std::memory_order_relaxed);
+        if (load > worstLoad.load(std::memory_order_relaxed))
+            worstLoad.store(load, std::memory_order_relaxed);
+
+        if (load <= nearMissThreshold.load(std::memory_order_relaxed))
+            return;
+
+        (load > 1.0f ? misses : nearMisses).fetch_add(1, std::memory_order_relaxed);
+
+        const uint64_t index = eventsWritten.load(std::memory_order_relaxed);
+        auto& slot = events[index % NUM_EVENTS];
+        const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.time.store(std::chrono::duration<double>(start - created).count(), std::memory_order_relaxed);
+        slot.load.store(load, std::memory_order_relaxed);
+        slot.numSamples.store(numSamples, std::memory_order_relaxed);
+        slot.sampleRate.store(sampleRate, std::memory_order_relaxed);
+        slot.context.store(context, std::memory_order_relaxed);
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+        eventsWritten.store(index + 1, std::memory_order_release);
+    }
+
+    struct Slot
+    {
+        std::atomic<uint32_t> sequence { 0 };     // Odd while the audio thread is writing
+        std::atomic<double> time { 0.0 };
+        std::atomic<float> load { 0.0f };
+        std::atomic<int> numSamples { 0 };
+        std::atomic<double> sampleRate { 0.0 };
+        std::atomic<uint32_t> context { 0 };
+    };
+
+    const std::chrono::steady_clock::time_point created = std::chrono::steady_clock::now();
+    std::atomic<float> nearMissThreshold { 0.7f };
+    std::atomic<uint32_t> bins[NUM_BINS] {};
+    std::atomic<uint64_t> blocks { 0 }, nearMisses { 0 }, misses { 0 };
+    std::atomic<float> worstLoad { 0.0f }, lastLoad { 0.0f };
+    Slot events[NUM_EVENTS];
+    std::atomic<uint64_t> eventsWritten { 0 };
+};
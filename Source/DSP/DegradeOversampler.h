@@ -0,0 +1,143 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "StateProbe.h"
+
+//==============================================================================
+// DegradeOversampler: Per-sample 2x/4x polyphase oversampling for one tap
+// Cascaded 63-tap halfband stages; only the even polyphase branch needs a
+// FIR, the odd branch is a pure delay. Wraps a nonlinear stage in-loop.
+//==============================================================================
+class DegradeOversampler
+{
+public:
+    static constexpr int PHASE_TAPS = 32;   // Even-branch taps of a 63-tap halfband
+
+    // Base-rate group delay of up + down for each factor (linear phase)
+    static constexpr float LATENCY_2X = PHASE_TAPS - 1.0f;
+    static constexpr float LATENCY_4X = 1.5f * LATENCY_2X;
+
+    void setFactor(int newFactor)
+    {
+        factor = newFactor;
+        reset();
+    }
+
+    int getFactor() const { return factor; }
+
+    float getLatency() const
+    {
+        return factor == 4 ? LATENCY_4X : factor == 2 ? LATENCY_2X : 0.0f;
+    }
+
+    void reset()
+    {
+        outer.reset();
+        inner.reset();
+    }
+
+    // Upsample, run 'stage' at the oversampled rate, decimate back
+    template <typename Stage>
+    float process(float input, Stage&& stage)
+    {
+        float up2[2];
+        outer.up(input, up2);
+
+        if (factor == 2)
+            return outer.down(stage(up2[0]), stage(up2[1]));
+
+        float up4[4];
+        inner.up(up2[0], up4);
+        inner.up(up2[1], up4 + 2);
+        const float first = inner.down(stage(up4[0]), stage(up4[1]));
+        const float second = inner.down(stage(up4[2]), stage(up4[3]));
+        return outer.down(first, second);
+    }
+
+    void probeState(StateProbe& probe) const
+    {
+        for (const auto* stage : { &outer, &inner })
+        {
+            probe.visit("upHistory", stage->upHistory);
+            probe.visit("downEven", stage->downEven);
+            probe.visit("downOdd", stage->downOdd);
+        }
+    }
+
+private:
+    static constexpr int CENTRE = PHASE_TAPS / 2 - 1;   // Odd branch: pure delay, in input samples
+
+    // Blackman-windowed halfband, even branch normalised to 0.5 (unity DC)
+    static const float* evenPhase()
+    {
+        static const auto coefficients = []
+        {
+            std::array<float, PHASE_TAPS> c {};
+            const double centre = PHASE_TAPS - 1.0;           // Full filter centre tap
+            const double length = 2.0 * centre;               // Full filter length - 1
+            double sum = 0.0;
+            for (int j = 0; j < PHASE_TAPS; ++j)
+            {
+                const double n = 2.0 * j;
+                const double t = (n - centre) * 0.5;
+                const double sinc = std::sin(juce::MathConstants<double>::pi * t) / (juce::MathConstants<double>::pi * t);
+                const double w = 0.42 - 0.5 * std::cos(2.0 * juce::MathConstants<double>::pi * n / length)
+                                      + 0.08 * std::cos(4.0 * juce::MathConstants<double>::pi * n / length);
+                c[static_cast<size_t>(j)] = static_cast<float>(0.5 * sinc * w);
+                sum += 0.5 * sinc * w;
+            }
+            for (auto& v : c)
+                v = static_cast<float>(v * 0.5 / sum);
+            return c;
+        }();
+        return coefficients.data();
+    }
+
+    struct HalfbandStage
+    {
+        // One input sample -> two output samples
+        void up(float input, float* output)
+        {
+            upHistory[upPos] = input;
+            float even = 0.0f;
+            for (int j = 0; j < PHASE_TAPS; ++j)
+                even += h[j] * upHistory[(upPos - j) & (PHASE_TAPS - 1)];
+            output[0] = 2.0f * even;
+            output[1] = upHistory[(upPos - CENTRE) & (PHASE_TAPS - 1)];
+            upPos = (upPos + 1) & (PHASE_TAPS - 1);
+        }
+
+        // Two input samples -> one output sample
+        float down(float first, float second)
+        {
+            downEven[downPos] = first;
+            float even = 0.0f;
+            for (int j = 0; j < PHASE_TAPS; ++j)
+                even += h[j] * downEven[(downPos - j) & (PHASE_TAPS - 1)];
+            downPos = (downPos + 1) & (PHASE_TAPS - 1);
+
+            const float odd = downOdd[oddPos];
+            downOdd[oddPos] = second;
+            oddPos = (oddPos + 1) & (ODD_DEPTH - 1);
+            return even + 0.5f * odd;
+        }
+
+        void reset()
+        {
+            std::fill(std::begin(upHistory), std::end(upHistory), 0.0f);
+            std::fill(std::begin(downEven), std::end(downEven), 0.0f);
+            std::fill(std::begin(downOdd), std::end(downOdd), 0.0f);
+            upPos = downPos = oddPos = 0;
+        }
+
+        static constexpr int ODD_DEPTH = CENTRE + 1;
+        const float* h = evenPhase();   // Table built at construction, never on the audio thread
+        float upHistory[PHASE_TAPS] = {};
+        float downEven[PHASE_TAPS] = {};
+        float downOdd[ODD_DEPTH] = {};
+        int upPos = 0, downPos = 0, oddPos = 0;
+    };
+
+    int factor = 1;
+    HalfbandStage outer, inner;
+};
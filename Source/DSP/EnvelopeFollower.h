@@ -0,0 +1,62 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "StateProbe.h"
+
+//==============================================================================
+// EnvelopeFollower: Bow dynamics detection
+// Fast attack, slow decay for tracking bow envelope
+//==============================================================================
+class EnvelopeFollower
+{
+public:
+    void prepare(double sampleRate)
+    {
+        sr = sampleRate;
+        // Attack: 1ms, Release: 100ms (for bow envelope following)
+        attackCoeff = std::exp(-1.0f / (static_cast<float>(sr) * 0.001f));
+        releaseCoeff = std::exp(-1.0f / (static_cast<float>(sr) * 0.1f));
+        reset();
+    }
+
+    void setSensitivity(float sensitivity)
+    {
+        this->sensitivity = sensitivity;
+    }
+
+    float process(float input)
+    {
+        float absInput = std::abs(input);
+
+        if (absInput > envelope)
+        {
+            envelope = absInput + (envelope - absInput) * attackCoeff;
+        }
+        else
+        {
+            envelope = absInput + (envelope - absInput) * releaseCoeff;
+        }
+
+        // Apply sensitivity scaling
+        return envelope * (0.5f + sensitivity * 0.5f);
+    }
+
+    void reset()
+    {
+        envelope = 0.0f;
+    }
+
+    float getCurrent() const { return envelope; }
+
+    void probeState(StateProbe& probe) const
+    {
+        probe.visit("envelope", envelope);
+    }
+
+private:
+    double sr = 44100.0;
+    float attackCoeff = 0.99f;
+    float releaseCoeff = 0.999f;
+    float envelope = 0.0f;
+    float sensitivity = 0.5f;
+};
@@ -0,0 +1,201 @@
+#include "FeedbackSuppressor.h"
+
+//==============================================================================
+void FeedbackSuppressor::prepare(double sampleRate)
+{
+    stopThread(1000);
+
+    sr = sampleRate;
+    fifo.setTotalSize(FIFO_SIZE);
+    fifo.reset();
+    fifoBuffer.assign(FIFO_SIZE, 0.0f);
+    stagingCount = 0;
+
+    history.assign(FFT_SIZE, 0.0f);
+    historyPos = 0;
+    hopCounter = 0;
+    fftData.assign(2 * FFT_SIZE, 0.0f);
+    magnitudeDb.assign(FFT_SIZE / 2 + 1, 0.0f);
+    window.resize(FFT_SIZE);
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), FFT_SIZE,
+        juce::dsp::WindowingFunction<float>::hann, false);
+
+    for (auto& c : candidates) c = {};
+    for (int i = 0; i < NUM_NOTCHES; ++i)
+    {
+        tracked[i] = {};
+        assignments[i] = 0;
+        published[i].freq.store(0.0f);
+        published[i].depthDb.store(0.0f);
+        published[i].assignment.store(0);
+        designedFreq[i] = 0.0f;
+        designedDepthDb[i] = 0.0f;
+        designedAssignment[i] = 0;
+    }
+    activeMask = 0;
+    reset();
+
+    startThread(juce::Thread::Priority::low);
+}
+
+void FeedbackSuppressor::run()
+{
+    while (!threadShouldExit())
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+        consume(fifoBuffer.data() + start1, size1);
+        consume(fifoBuffer.data() + start2, size2);
+        fifo.finishedRead(size1 + size2);
+
+        wait(10);
+    }
+}
+
+void FeedbackSuppressor::consume(const float* data, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        history[static_cast<size_t>(historyPos)] = data[i];
+        historyPos = (historyPos + 1) & (FFT_SIZE - 1);
+        if (++hopCounter == HOP_SIZE)
+        {
+            hopCounter = 0;
+            analyse();
+        }
+    }
+}
+
+void FeedbackSuppressor::analyse()
+{
+    ABYSS_TRACE_SCOPE("howl analysis", "howl analysis worker");
+    std::fill(fftData.begin(), fftData.end(), 0.0f);
+    for (int i = 0; i < FFT_SIZE; ++i)
+        fftData[static_cast<size_t>(i)] = history[static_cast<size_t>((historyPos + i) & (FFT_SIZE - 1))] * window[static_cast<size_t>(i)];
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    // Hann coherent gain 0.5 -> full-scale sine reads ~0 dB
+    const float norm = 4.0f / static_cast<float>(FFT_SIZE);
+    for (int k = 0; k <= FFT_SIZE / 2; ++k)
+        magnitudeDb[static_cast<size_t>(k)] = 20.0f * std::log10(fftData[static_cast<size_t>(k)] * norm + 1.0e-9f);
+
+    const float binHz = static_cast<float>(sr) / static_cast<float>(FFT_SIZE);
+    const int minBin = juce::jmax(3, static_cast<int>(MIN_FREQ / binHz));
+    const int maxBin = juce::jmin(FFT_SIZE / 4 - 2, static_cast<int>(MAX_FREQ / binHz)); // 2nd harmonic stays below Nyquist
+
+    for (auto& c : candidates) c.seen = false;
+
+    for (int k = minBin; k <= maxBin; ++k)
+    {
+        float peak = binDb(k);
+        if (peak < MIN_LEVEL_DB || peak <= binDb(k - 1) || peak < binDb(k + 1))
+            continue;
+
+        // Peak-to-neighbour ratio (skip the main lobe)
+        float sum = 0.0f;
+        for (int j = 3; j <= 16; ++j)
+            sum += binDb(k - j) + binDb(k + j);
+        if (peak - sum / 28.0f < PEAK_TO_NEIGHBOUR_DB)
+            continue;
+
+        // Peak-to-harmonic ratio
+        float harmonic = juce::jmax(binDb(2 * k - 1), binDb(2 * k), binDb(2 * k + 1));
+        if (peak - harmonic < PEAK_TO_HARMONIC_DB)
+            continue;
+
+        trackCandidate(k, peak);
+    }
+
+    // Forget candidates that vanished this frame
+    for (auto& c : candidates)
+        if (! c.seen)
+            c = {};
+
+    // Release notches that have been idle long enough
+    for (int i = 0; i < NUM_NOTCHES; ++i)
+    {
+        Tracked& t = tracked[i];
+        if (t.freq <= 0.0f)
+            continue;
+
+        if (++t.idleFrames > HOLD_FRAMES)
+        {
+            t.depthDb += RELEASE_STEP_DB;
+            if (t.depthDb >= 0.0f)
+                t = {};
+        }
+
+        publish(i);
+    }
+}
+
+void FeedbackSuppressor::publish(int index)
+{
+    PublishedNotch& p = published[index];
+    const uint32_t sequence = p.sequence.load(std::memory_order_relaxed);
+    p.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    p.freq.store(tracked[index].freq, std::memory_order_relaxed);
+    p.depthDb.store(tracked[index].depthDb, std::memory_order_relaxed);
+    p.assignment.store(assignments[index], std::memory_order_relaxed);
+    p.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void FeedbackSuppressor::trackCandidate(int bin, float peakDb)
+{
+    Candidate* slot = nullptr;
+    for (auto& c : candidates)
+    {
+        if (c.bin >= 0 && std::abs(c.bin - bin) <= 1) { slot = &c; break; }
+        if (slot == nullptr && c.bin < 0) slot = &c;
+    }
+    if (slot == nullptr)
+        return;
+
+    // Howl is steady or growing; decaying peaks are ringing notes
+    if (slot->bin >= 0 && peakDb < slot->lastDb - 1.0f)
+        slot->count = 0;
+
+    if (slot->bin < 0) slot->count = 0;
+    slot->bin = bin;
+    slot->lastDb = peakDb;
+    slot->seen = true;
+
+    if (++slot->count >= PERSIST_FRAMES)
+    {
+        // Parabolic interpolation for the true peak frequency
+        float l = binDb(bin - 1), c = binDb(bin), r = binDb(bin + 1);
+        float denom = l - 2.0f * c + r;
+        float offset = std::abs(denom) > 1.0e-6f ? 0.5f * (l - r) / denom : 0.0f;
+        float freq = (static_cast<float>(bin) + offset) * static_cast<float>(sr) / static_cast<float>(FFT_SIZE);
+
+        engageNotch(freq);
+        slot->count = PERSIST_FRAMES / 2;   // Re-confirm before deepening again
+    }
+}
+
+void FeedbackSuppressor::engageNotch(float freq)
+{
+    int target = -1;
+    for (int i = 0; i < NUM_NOTCHES && target < 0; ++i)
+        if (tracked[i].freq > 0.0f && std::abs(tracked[i].freq - freq) < freq * 0.02f)
+            target = i;
+
+    if (target < 0)
+    {
+        // Free slot, else steal the shallowest notch
+        float shallowest = -1000.0f;
+        for (int i = 0; i < NUM_NOTCHES; ++i)
+        {
+            if (tracked[i].freq <= 0.0f) { target = i; break; }
+            if (tracked[i].depthDb > shallowest) { shallowest = tracked[i].depthDb; target = i; }
+        }
+        tracked[target] = {};
+        tracked[target].freq = freq;
+        ++assignments[target];
+    }
+
+    Tracked& t = tracked[target];
+    t.depthDb = juce::jmax(MAX_DEPTH_DB, t.depthDb + DEPTH_STEP_DB);
+    t.idleFrames = 0;
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "StateProbe.h"
+#include "TraceRecorder.h"
+
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+// FeedbackSuppressor: Adaptive howl suppression ahead of the conditioner
+// Audio thread only runs a bank of narrow peaking-cut biquads and stages the
+// input into a lock-free FIFO. A worker thread does FFT peak detection
+// (peak-to-neighbour, peak-to-harmonic, persistence) and publishes each
+// notch as one record behind a sequence number, picked up once per block, so
+// a frequency is never paired with another notch's depth.
+//==============================================================================
+class FeedbackSuppressor : private juce::Thread
+{
+public:
+    static constexpr int NUM_NOTCHES = 8;
+
+    FeedbackSuppressor() : juce::Thread("AbyssVerb Howl Analysis") {}
+    ~FeedbackSuppressor() override { stopThread(1000); }
+
+    // Message thread: allocate everything and (re)start the worker
+    void prepare(double sampleRate);
+
+    void release() { stopThread(1000); }
+
+    // Audio thread, once per block: redesign any notch the worker has moved
+    void beginBlock()
+    {
+        for (int i = 0; i < NUM_NOTCHES; ++i)
+        {
+            float freq, depth;
+            uint32_t assignment;
+            if (! readPublished(i, freq, depth, assignment))
+                continue;   // Worker mid-write: keep the current design for this block
+
+            if (freq == designedFreq[i] && depth == designedDepthDb[i] && assignment == designedAssignment[i])
+                continue;
+
+            // A slot given to a new howl must not ring with the old one's state
+            const bool reassigned = assignment != designedAssignment[i];
+            designedFreq[i] = freq;
+            designedDepthDb[i] = depth;
+            designedAssignment[i] = assignment;
+
+            if (freq <= 0.0f || depth > -0.1f)
+            {
+                activeMask &= ~(1u << i);
+                continue;
+            }
+
+            // Narrow peaking cut (RBJ), Q ~ 1/10 octave
+            float omega = 2.0f * juce::MathConstants<float>::pi * freq / static_cast<float>(sr);
+            float alpha = std::sin(omega) / (2.0f * NOTCH_Q);
+            float A = std::pow(10.0f, depth / 40.0f);
+            float a0 = 1.0f + alpha / A;
+            notch[i].b0 = (1.0f + alpha * A) / a0;
+            notch[i].b1 = (-2.0f * std::cos(omega)) / a0;
+            notch[i].b2 = (1.0f - alpha * A) / a0;
+            notch[i].a1 = notch[i].b1;
+            notch[i].a2 = (1.0f - alpha / A) / a0;
+
+            if ((activeMask & (1u << i)) == 0 || reassigned)
+                notch[i].z1[0] = notch[i].z1[1] = notch[i].z2[0] = notch[i].z2[1] = 0.0f;
+            activeMask |= (1u << i);
+        }
+    }
+
+    // Audio thread: analyse the raw input, then notch both channels
+    void process(float& left, float& right)
+    {
+        staging[stagingCount++] = 0.5f * (left + right);
+        if (stagingCount == STAGING_SIZE)
+            flushStaging();
+
+        for (int i = 0; i < NUM_NOTCHES; ++i)
+        {
+            if ((activeMask & (1u << i)) == 0)
+                continue;
+
+            Notch& n = notch[i];
+            float outL = n.b0 * left + n.z1[0];
+            n.z1[0] = n.b1 * left - n.a1 * outL + n.z2[0];
+            n.z2[0] = n.b2 * left - n.a2 * outL;
+            left = outL;
+
+            float outR = n.b0 * right + n.z1[1];
+            n.z1[1] = n.b1 * right - n.a1 * outR + n.z2[1];
+            n.z2[1] = n.b2 * right - n.a2 * outR;
+            right = outR;
+        }
+    }
+
+    void reset()
+    {
+        for (auto& n : notch)
+            n.z1[0] = n.z1[1] = n.z2[0] = n.z2[1] = 0.0f;
+    }
+
+    // Worker-published notch state, for display
+    float getNotchFrequency(int index) const { return published[index].freq.load(); }
+    float getNotchDepthDb(int index) const { return published[index].depthDb.load(); }
+
+    void probeState(StateProbe& probe) const
+    {
+        for (const auto& n : notch)
+        {
+            probe.visit("notchZ1", n.z1);
+            probe.visit("notchZ2", n.z2);
+        }
+    }
+
+private:
+    static constexpr int FFT_ORDER = 12;
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;      // ~85 ms at 48 kHz
+    static constexpr int HOP_SIZE = FFT_SIZE / 4;
+    static constexpr int FIFO_SIZE = 1 << 15;
+    static constexpr int STAGING_SIZE = 128;
+    static constexpr int NUM_CANDIDATES = 16;
+    static constexpr float NOTCH_Q = 14.0f;
+    static constexpr float MIN_FREQ = 150.0f;           // Below violin G3 there is nothing to ring
+    static constexpr float MAX_FREQ = 12000.0f;
+    static constexpr float PEAK_TO_NEIGHBOUR_DB = 15.0f;
+    static constexpr float PEAK_TO_HARMONIC_DB = 18.0f; // Bowed notes carry strong partials, howl does not
+    static constexpr float MIN_LEVEL_DB = -50.0f;
+    static constexpr int PERSIST_FRAMES = 6;            // ~130 ms of sustained growth at 48 kHz
+    static constexpr float DEPTH_STEP_DB = -3.0f;
+    static constexpr float MAX_DEPTH_DB = -24.0f;
+    static constexpr float RELEASE_STEP_DB = 0.25f;
+    static constexpr int HOLD_FRAMES = 200;             // ~4 s before a notch starts releasing
+
+    struct Notch
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+        float z1[2] = {}, z2[2] = {};
+    };
+
+    struct Candidate { int bin = -1; int count = 0; float lastDb = -200.0f; bool seen = false; };
+    struct Tracked { float freq = 0.0f; float depthDb = 0.0f; int idleFrames = 0; };
+
+    // One notch as the audio thread sees it; written by the worker only
+    struct PublishedNotch
+    {
+        std::atomic<uint32_t> sequence { 0 };       // Odd while the worker is writing
+        std::atomic<float> freq { 0.0f }, depthDb { 0.0f };
+        std::atomic<uint32_t> assignment { 0 };     // Bumped each time the slot takes a new howl
+    };
+
+    // Audio thread: false if the worker kept the record busy
+    bool readPublished(int index, float& freq, float& depthDb, uint32_t& assignment) const
+    {
+        const PublishedNotch& p = published[index];
+        for (int attempt = 0; attempt < 4; ++attempt)
+        {
+            const uint32_t before = p.sequence.load(std::memory_order_acquire);
+            if (before & 1u)
+                continue;
+            freq = p.freq.load(std::memory_order_relaxed);
+            depthDb = p.depthDb.load(std::memory_order_relaxed);
+            assignment = p.assignment.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (p.sequence.load(std::memory_order_relaxed) == before)
+                return true;
+        }
+        return false;
+    }
+
+    void flushStaging()
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(stagingCount, start1, size1, start2, size2);
+        if (size1 > 0) std::copy(staging, staging + size1, fifoBuffer.data() + start1);
+        if (size2 > 0) std::copy(staging + size1, staging + size1 + size2, fifoBuffer.data() + start2);
+        fifo.finishedWrite(size1 + size2);   // Samples that do not fit are dropped
+        stagingCount = 0;
+    }
+
+    float binDb(int bin) const
+    {
+        return magnitudeDb[static_cast<size_t>(juce::jlimit(0, FFT_SIZE / 2, bin))];
+    }
+
+    // Worker thread
+    void run() override;
+    void consume(const float* data, int numSamples);
+    void analyse();
+    void trackCandidate(int bin, float peakDb);
+    void engageNotch(float freq);
+    void publish(int index);
+
+    double sr = 44100.0;
+
+    // Audio thread
+    Notch notch[NUM_NOTCHES];
+    float designedFreq[NUM_NOTCHES] = {};
+    float designedDepthDb[NUM_NOTCHES] = {};
+    uint32_t designedAssignment[NUM_NOTCHES] = {};
+    uint32_t activeMask = 0;
+    float staging[STAGING_SIZE] = {};
+    int stagingCount = 0;
+
+    // Shared
+    juce::AbstractFifo fifo { FIFO_SIZE };
+    std::vector<float> fifoBuffer;
+    PublishedNotch published[NUM_NOTCHES];
+
+    // Worker thread
+    juce::dsp::FFT fft { FFT_ORDER };
+    std::vector<float> history, fftData, magnitudeDb, window;
+    int historyPos = 0;
+    int hopCounter = 0;
+    Candidate candidates[NUM_CANDIDATES];
+    Tracked tracked[NUM_NOTCHES];
+    uint32_t assignments[NUM_NOTCHES] = {};
+};
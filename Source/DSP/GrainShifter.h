@@ -0,0 +1,137 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "StateProbe.h"
+
+#include <vector>
+
+//==============================================================================
+// GrainShifter: Granular pitch shifter for the shimmer feedback paths
+// Hann grains (table lookup) from a fixed pool, spawned every half grain so
+// two overlap and sum to unity; a full pool skips the spawn.
+//==============================================================================
+class GrainShifter
+{
+public:
+    static constexpr int MAX_GRAINS = 4;
+    static constexpr float MAX_RATIO = 2.0f;
+
+    void prepare(double sampleRate)
+    {
+        grainLength = juce::jmax(64, static_cast<int>(sampleRate * GRAIN_SECONDS));
+        hop = grainLength / 2;
+        phaseInc = 1.0f / static_cast<float>(grainLength);
+
+        // Longest look-back: an octave-up grain starts (ratio - 1) * length behind the writer
+        ringSize = juce::nextPowerOfTwo(static_cast<int>(static_cast<float>(grainLength) * (MAX_RATIO - 1.0f)) + 4);
+        mask = ringSize - 1;
+        buffer.assign(static_cast<size_t>(ringSize), 0.0f);
+        reset();
+    }
+
+    void setRatio(float newRatio) { ratio = juce::jlimit(1.0f, MAX_RATIO, newRatio); }
+
+    void reset()
+    {
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+        for (auto& g : grains)
+            g.active = false;
+        writePos = 0;
+        hopCountdown = 0;
+    }
+
+    float process(float input)
+    {
+        buffer[static_cast<size_t>(writePos)] = input;
+
+        if (--hopCountdown <= 0)
+        {
+            hopCountdown = hop;
+            spawn();
+        }
+
+        float output = 0.0f;
+        for (auto& g : grains)
+        {
+            if (! g.active)
+                continue;
+
+            const float tablePos = g.phase * static_cast<float>(WINDOW_SIZE);
+            const int tableIndex = static_cast<int>(tablePos);
+            const float w = window[tableIndex] + (tablePos - static_cast<float>(tableIndex))
+                                               * (window[tableIndex + 1] - window[tableIndex]);
+
+            const int index = static_cast<int>(g.readPos);
+            const float frac = g.readPos - static_cast<float>(index);
+            const float a = buffer[static_cast<size_t>(index & mask)];
+            const float b = buffer[static_cast<size_t>((index + 1) & mask)];
+            output += w * (a + frac * (b - a));
+
+            g.readPos += ratio;
+            if (g.readPos >= static_cast<float>(ringSize))
+                g.readPos -= static_cast<float>(ringSize);
+            g.phase += phaseInc;
+            if (g.phase >= 1.0f)
+                g.active = false;
+        }
+
+        writePos = (writePos + 1) & mask;
+        return output;
+    }
+
+    void probeState(StateProbe& probe) const
+    {
+        probe.visit("grainBuffer", buffer);
+    }
+
+private:
+    static constexpr float GRAIN_SECONDS = 0.04f;
+    static constexpr int WINDOW_SIZE = 512;
+
+    struct Grain
+    {
+        float readPos = 0.0f;
+        float phase = 0.0f;
+        bool active = false;
+    };
+
+    // Start far enough back that a grain reading at 'ratio' never overtakes the writer
+    void spawn()
+    {
+        for (auto& g : grains)
+        {
+            if (g.active)
+                continue;
+
+            float start = static_cast<float>(writePos) - (ratio - 1.0f) * static_cast<float>(grainLength) - 2.0f;
+            if (start < 0.0f)
+                start += static_cast<float>(ringSize);
+            g.readPos = start;
+            g.phase = 0.0f;
+            g.active = true;
+            return;
+        }
+    }
+
+    // Periodic Hann (plus guard point): 50% overlapped grains sum to exactly 1
+    static const float* hannTable()
+    {
+        static const auto table = []
+        {
+            std::array<float, WINDOW_SIZE + 1> t {};
+            for (int i = 0; i <= WINDOW_SIZE; ++i)
+                t[static_cast<size_t>(i)] = 0.5f - 0.5f * std::cos(2.0f * juce::MathConstants<float>::pi
+                                                                   * static_cast<float>(i) / static_cast<float>(WINDOW_SIZE));
+            return t;
+        }();
+        return table.data();
+    }
+
+    const float* window = hannTable();   // Built at construction, never on the audio thread
+    std::vector<float> buffer;
+    int ringSize = 1, mask = 0, writePos = 0;
+    int grainLength = 1764, hop = 882, hopCountdown = 0;
+    float phaseInc = 1.0f / 1764.0f;
+    float ratio = 2.0f;
+    Grain grains[MAX_GRAINS];
+};
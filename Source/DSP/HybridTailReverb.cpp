@@ -0,0 +1,79 @@
+#include "HybridTailReverb.h"
+
+//==============================================================================
+void HybridTailReverb::prepare(double sampleRate)
+{
+    stopThread(2000);
+
+    sr = sampleRate;
+    active.reset();
+    pending.reset();
+    retired.reset();
+    hasPending = false;
+    captureRequested.store(false);
+    lastRequested = {};
+
+    convGain = 0.0f;
+    xfadeStep = 1.0f / static_cast<float>(sr * 0.05);   // 50 ms output crossfade
+    convFed = false;
+    convFedSamples = 0;
+
+    startThread(juce::Thread::Priority::low);
+}
+
+void HybridTailReverb::run()
+{
+    while (! threadShouldExit())
+    {
+        if (captureRequested.exchange(false, std::memory_order_acquire))
+        {
+            Settings settings;
+            settings.decay = requestedDecay.load();
+            settings.dampHigh = requestedDampHigh.load();
+            settings.dampLow = requestedDampLow.load();
+            capture(settings);
+        }
+
+        wait(20);
+    }
+}
+
+void HybridTailReverb::capture(const Settings& settings)
+{
+    ABYSS_TRACE_SCOPE("tail capture", "tail capture worker");
+    AbyssFDNReverb fdn;
+    fdn.prepare(sr, 512);
+    fdn.clear();
+    fdn.setParameters(settings.decay, settings.dampHigh, settings.dampLow, 0.0f, 0.3f, 0.0f);
+
+    // RT60 length: -60 dB at the end, short fade to avoid a step
+    const int length = static_cast<int>(sr * juce::jmin(static_cast<double>(settings.decay), MAX_TAIL_SECONDS));
+    std::vector<float> ir(static_cast<size_t>(length));
+    for (int n = 0; n < length; ++n)
+    {
+        ir[static_cast<size_t>(n)] = fdn.process(n == 0 ? 1.0f : 0.0f);
+        if ((n & 4095) == 0 && (threadShouldExit() || captureRequested.load()))
+            return;   // Superseded
+    }
+
+    const int fadeLength = length / 10;
+    for (int n = 0; n < fadeLength; ++n)
+        ir[static_cast<size_t>(length - 1 - n)] *= 0.5f - 0.5f * std::cos(juce::MathConstants<float>::pi
+                                                      * static_cast<float>(n) / static_cast<float>(fadeLength));
+
+    auto kernel = std::make_shared<const TailConvolver::Kernel>(ir.data(), length);
+    auto result = std::make_unique<Capture>();
+    result->settings = settings;
+    result->flushLength = length + TailConvolver::MAX_LAG * (1 << (TailConvolver::MAX_FFT_ORDER - 1));
+    result->left = std::make_unique<TailConvolver::Engine>(kernel);
+    result->right = std::make_unique<TailConvolver::Engine>(kernel);
+
+    std::unique_ptr<Capture> garbage;
+    {
+        const juce::SpinLock::ScopedLockType lock(swapLock);
+        garbage = std::move(retired);
+        std::swap(pending, result);
+        hasPending = true;
+    }
+    // Previous unclaimed capture and retired capture are freed here, on the worker
+}
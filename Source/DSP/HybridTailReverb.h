@@ -0,0 +1,149 @@
+#pragma once
+
+#include "AbyssFDNReverb.h"
+#include "TailConvolver.h"
+#include "StateProbe.h"
+#include "TraceRecorder.h"
+
+#include <atomic>
+
+//==============================================================================
+// HybridTailReverb: FDN / captured-convolution hybrid for static settings
+// With modulation at zero the FDN is linear time-invariant. Once parameters
+// have been still for a moment, a worker thread renders the FDN's impulse
+// response and builds a TailConvolver, which is then fed the same input as
+// the FDN. Once everything the convolver holds came from that feed, the
+// output crossfades over to it; any change (parameters, freeze) crossfades
+// straight back. The live FDN keeps running on the full input throughout, so
+// it always holds the whole tail when it has to take over: a freeze engaged
+// while the convolver is heard holds the same sound.
+//==============================================================================
+class HybridTailReverb : private juce::Thread
+{
+public:
+    struct Settings
+    {
+        float decay = 0.0f, dampHigh = 0.0f, dampLow = 0.0f;
+
+        bool operator==(const Settings& other) const
+        {
+            return decay == other.decay && dampHigh == other.dampHigh && dampLow == other.dampLow;
+        }
+        bool operator!=(const Settings& other) const { return ! (*this == other); }
+    };
+
+    static constexpr double MAX_TAIL_SECONDS = 30.0;
+
+    HybridTailReverb() : juce::Thread("AbyssVerb Tail Capture") {}
+    ~HybridTailReverb() override { stopThread(2000); }
+
+    // Message thread
+    void prepare(double sampleRate);
+
+    void release() { stopThread(2000); }
+
+    // Audio thread, once per block
+    void beginBlock(bool enabled, const Settings& current, bool parametersStatic)
+    {
+        // A new capture may only replace the convolver while it is not heard
+        if (convGain <= 0.0f)
+        {
+            const juce::SpinLock::ScopedTryLockType lock(swapLock);
+            if (lock.isLocked() && hasPending && retired == nullptr)
+            {
+                retired = std::move(active);
+                active = std::move(pending);
+                hasPending = false;
+                convFedSamples = 0;
+            }
+        }
+
+        const bool matches = active != nullptr && active->settings == current;
+        convFed = enabled && parametersStatic && matches;
+        if (! convFed)
+            convFedSamples = 0;
+
+        if (enabled && parametersStatic && ! matches && current != lastRequested)
+        {
+            requestedDecay.store(current.decay);
+            requestedDampHigh.store(current.dampHigh);
+            requestedDampLow.store(current.dampLow);
+            captureRequested.store(true, std::memory_order_release);
+            lastRequested = current;
+        }
+    }
+
+    // Audio thread: replaces the direct FDN calls
+    void process(AbyssFDNReverb& fdnL, AbyssFDNReverb& fdnR,
+                 float inL, float inR, float& outL, float& outR)
+    {
+        outL = fdnL.process(inL);
+        outR = fdnR.process(inR);
+
+        // Heard once it has been fed for longer than anything it can still hold
+        const bool loaded = convFed && convFedSamples >= active->flushLength;
+        if (loaded)               convGain = juce::jmin(1.0f, convGain + xfadeStep);
+        else if (convGain > 0.0f) convGain = juce::jmax(0.0f, convGain - xfadeStep);
+
+        // Unheard and unfed, the convolver is skipped; the feed flushes its
+        // stale history out before it is heard again
+        if (convFed || convGain > 0.0f)
+        {
+            const float feed = convFed ? 1.0f : 0.0f;
+            const float l = active->left->process(inL * feed);
+            const float r = active->right->process(inR * feed);
+            outL += convGain * (l - outL);
+            outR += convGain * (r - outR);
+
+            if (convFed && convFedSamples < active->flushLength)
+                ++convFedSamples;
+        }
+    }
+
+    // Audio thread: drops the convolution tail, e.g. when another engine takes over
+    // Callers clear the FDNs themselves. The convolver's history is left stale:
+    // it is not heard again until a full feed has flushed it
+    void clear()
+    {
+        convGain = 0.0f;
+        convFedSamples = 0;
+    }
+
+    bool isConvolutionActive() const { return convGain > 0.0f; }
+
+    void probeState(StateProbe& probe) const
+    {
+        if (active != nullptr)
+        {
+            active->left->probeState(probe);
+            active->right->probeState(probe);
+        }
+    }
+
+private:
+    struct Capture
+    {
+        Settings settings;
+        int flushLength = 0;
+        std::unique_ptr<TailConvolver::Engine> left, right;
+    };
+
+    // Worker thread: render the FDN impulse response and build the convolver
+    void run() override;
+    void capture(const Settings& settings);
+
+    double sr = 44100.0;
+
+    // Audio thread
+    float convGain = 0.0f, xfadeStep = 0.001f;     // Output crossfade, FDN -> convolver
+    bool convFed = false;
+    int convFedSamples = 0;
+    Settings lastRequested;
+
+    // Shared
+    std::atomic<bool> captureRequested { false };
+    std::atomic<float> requestedDecay { 0.0f }, requestedDampHigh { 0.0f }, requestedDampLow { 0.0f };
+    std::unique_ptr<Capture> active, pending, retired;
+    bool hasPending = false;
+    juce::SpinLock swapLock;
+};
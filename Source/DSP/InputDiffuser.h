@@ -0,0 +1,138 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "StateProbe.h"
+
+#include <vector>
+
+//==============================================================================
+// InputDiffuser: Early reflections + nested allpass diffusion ahead of the FDN
+// Eight early-reflection taps read from one shared input ring, then two
+// nested allpass pairs smear the onset so the FDN starts dense.
+//==============================================================================
+class InputDiffuser
+{
+public:
+    static constexpr int NUM_ER_TAPS = 8;
+    static constexpr int NUM_ALLPASS = 2;
+
+    // spread scales all delay times so L/R decorrelate
+    void prepare(double sampleRate, float spread)
+    {
+        sr = sampleRate;
+        const float msToSamples = static_cast<float>(sr) / 1000.0f * spread;
+
+        // Early reflections: prime-ish times, decaying gains, alternating sign
+        const float tapMs[NUM_ER_TAPS]    = { 7.1f, 11.3f, 17.9f, 23.3f, 31.7f, 41.3f, 53.9f, 67.1f };
+        const float tapGains[NUM_ER_TAPS] = { 0.62f, -0.55f, 0.49f, -0.43f, 0.37f, -0.31f, 0.26f, -0.21f };
+
+        int maxTap = 0;
+        for (int k = 0; k < NUM_ER_TAPS; ++k)
+        {
+            erOffsets[k] = juce::jmax(1, static_cast<int>(tapMs[k] * msToSamples));
+            erGains[k] = tapGains[k];
+            maxTap = juce::jmax(maxTap, erOffsets[k]);
+        }
+        erBuffer.assign(static_cast<size_t>(juce::nextPowerOfTwo(maxTap + 1)), 0.0f);
+        erMask = static_cast<int>(erBuffer.size()) - 1;
+        erWritePos = 0;
+
+        // Nested allpass pairs (outer, inner)
+        const float outerMs[NUM_ALLPASS] = { 7.9f, 12.6f };
+        const float innerMs[NUM_ALLPASS] = { 2.6f, 4.8f };
+        for (int a = 0; a < NUM_ALLPASS; ++a)
+        {
+            outer[a].prepare(juce::jmax(1, static_cast<int>(outerMs[a] * msToSamples)), OUTER_GAIN);
+            inner[a].prepare(juce::jmax(1, static_cast<int>(innerMs[a] * msToSamples)), INNER_GAIN);
+        }
+    }
+
+    void setAmount(float diffusion)
+    {
+        amount = diffusion;
+    }
+
+    float process(float input)
+    {
+        // Early-reflection taps from the shared ring
+        erBuffer[static_cast<size_t>(erWritePos)] = input;
+        float er = 0.0f;
+        for (int k = 0; k < NUM_ER_TAPS; ++k)
+            er += erGains[k] * erBuffer[static_cast<size_t>((erWritePos - erOffsets[k]) & erMask)];
+        erWritePos = (erWritePos + 1) & erMask;
+
+        // Nested allpass chain
+        float diffused = input + er * amount;
+        for (int a = 0; a < NUM_ALLPASS; ++a)
+            diffused = outer[a].process(diffused, inner[a]);
+
+        return input + (diffused - input) * amount;
+    }
+
+    void clear()
+    {
+        std::fill(erBuffer.begin(), erBuffer.end(), 0.0f);
+        for (int a = 0; a < NUM_ALLPASS; ++a)
+        {
+            outer[a].clear();
+            inner[a].clear();
+        }
+    }
+
+    void probeState(StateProbe& probe) const
+    {
+        probe.visit("earlyReflections", erBuffer);
+        for (int i = 0; i < NUM_ALLPASS; ++i)
+        {
+            probe.visit("outerAllpass", outer[i].buffer);
+            probe.visit("innerAllpass", inner[i].buffer);
+        }
+    }
+
+private:
+    static constexpr float OUTER_GAIN = 0.6f;
+    static constexpr float INNER_GAIN = 0.45f;
+
+    // Schroeder allpass on a power-of-two ring; the outer one nests another inside its delay
+    struct Allpass
+    {
+        void prepare(int delaySamples, float g)
+        {
+            delay = delaySamples;
+            gain = g;
+            buffer.assign(static_cast<size_t>(juce::nextPowerOfTwo(delaySamples + 1)), 0.0f);
+            mask = static_cast<int>(buffer.size()) - 1;
+            writePos = 0;
+        }
+
+        float read() const { return buffer[static_cast<size_t>((writePos - delay) & mask)]; }
+
+        float write(float input, float delayed)
+        {
+            float v = input - gain * delayed;
+            buffer[static_cast<size_t>(writePos)] = v;
+            writePos = (writePos + 1) & mask;
+            return delayed + gain * v;
+        }
+
+        float process(float input) { return write(input, read()); }
+        float process(float input, Allpass& nested) { return write(input, nested.process(read())); }
+
+        void clear() { std::fill(buffer.begin(), buffer.end(), 0.0f); }
+
+        std::vector<float> buffer;
+        int delay = 1, mask = 0, writePos = 0;
+        float gain = 0.5f;
+    };
+
+    double sr = 44100.0;
+    float amount = 0.5f;
+
+    std::vector<float> erBuffer;
+    int erMask = 0;
+    int erWritePos = 0;
+    alignas(16) int erOffsets[NUM_ER_TAPS] = {};
+    alignas(16) float erGains[NUM_ER_TAPS] = {};
+
+    Allpass outer[NUM_ALLPASS], inner[NUM_ALLPASS];
+};
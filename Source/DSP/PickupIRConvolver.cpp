@@ -0,0 +1,25 @@
+#include "PickupIRConvolver.h"
+
+//==============================================================================
+PickupIRConvolver::Kernel::Kernel(const float* ir, int length)
+{
+    // Head taps stored reversed for a contiguous dot product
+    for (int i = 0; i < BLOCK_SIZE && i < length; ++i)
+        headReversed[BLOCK_SIZE - 1 - i] = ir[i];
+
+    numTailPartitions = juce::jmax(0, (length - 1) / BLOCK_SIZE);
+    tailSpectra.resize(static_cast<size_t>(numTailPartitions * NUM_BINS * 2), 0.0f);
+
+    std::vector<float> frame(2 * FFT_SIZE);
+    for (int p = 0; p < numTailPartitions; ++p)
+    {
+        std::fill(frame.begin(), frame.end(), 0.0f);
+        const int start = (p + 1) * BLOCK_SIZE;
+        const int count = juce::jmin(BLOCK_SIZE, length - start);
+        std::copy(ir + start, ir + start + count, frame.begin());
+
+        fft.performRealOnlyForwardTransform(frame.data(), true);
+        std::copy(frame.begin(), frame.begin() + NUM_BINS * 2,
+                  tailSpectra.begin() + p * NUM_BINS * 2);
+    }
+}
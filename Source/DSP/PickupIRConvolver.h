@@ -0,0 +1,179 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "StateProbe.h"
+
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// PickupIRConvolver: Measured pickup/body impulse response correction
+// Zero-latency uniformly-partitioned convolution: direct-form FIR head for the
+// first partition, FFT frequency-domain delay line for the tail. Engines are
+// built off the audio thread and handed over with a try-lock pointer swap.
+//==============================================================================
+class PickupIRConvolver
+{
+public:
+    static constexpr int BLOCK_SIZE = 64;              // Head length == partition size
+    static constexpr int FFT_ORDER = 7;                // FFT over 2 * BLOCK_SIZE
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+    static constexpr int NUM_BINS = FFT_SIZE / 2 + 1;
+    static constexpr double MAX_IR_SECONDS = 0.25;     // Pickup/body IRs are short
+
+    // Immutable IR partitions, shared between channels
+    struct Kernel
+    {
+        Kernel(const float* ir, int length);
+
+        juce::dsp::FFT fft { FFT_ORDER };
+        float headReversed[BLOCK_SIZE] = {};
+        int numTailPartitions = 0;
+        std::vector<float> tailSpectra; // Interleaved complex, NUM_BINS per partition
+    };
+
+    // Per-channel convolution state, allocated together with its kernel
+    class Engine
+    {
+    public:
+        explicit Engine(std::shared_ptr<const Kernel> k)
+            : kernel(std::move(k)),
+              frame(2 * FFT_SIZE, 0.0f),
+              accum(2 * FFT_SIZE, 0.0f),
+              inputSpectra(static_cast<size_t>(juce::jmax(1, kernel->numTailPartitions) * NUM_BINS * 2), 0.0f)
+        {
+        }
+
+        float process(float input)
+        {
+            // Mirrored history so the head FIR reads one contiguous span
+            historyPos = (historyPos + 1) & (BLOCK_SIZE - 1);
+            history[historyPos] = input;
+            history[historyPos + BLOCK_SIZE] = input;
+
+            const float* x = history + historyPos + 1;
+            float headOut = 0.0f;
+            for (int i = 0; i < BLOCK_SIZE; ++i)
+                headOut += kernel->headReversed[i] * x[i];
+
+            currentBlock[blockPos] = input;
+            float output = headOut + tailOut[blockPos];
+
+            if (++blockPos == BLOCK_SIZE)
+            {
+                blockPos = 0;
+                processTailBlock();
+            }
+
+            return output;
+        }
+
+        void probeState(StateProbe& probe) const
+        {
+            probe.visit("history", history);
+            probe.visit("previousBlock", previousBlock);
+            probe.visit("currentBlock", currentBlock);
+            probe.visit("tailOut", tailOut);
+            probe.visit("inputSpectra", inputSpectra);
+        }
+
+    private:
+        // Runs once per BLOCK_SIZE samples: produces the tail for the next block
+        void processTailBlock()
+        {
+            const int numParts = kernel->numTailPartitions;
+            if (numParts > 0)
+            {
+                // Overlap-save frame: previous + current block
+                std::copy(previousBlock, previousBlock + BLOCK_SIZE, frame.begin());
+                std::copy(currentBlock, currentBlock + BLOCK_SIZE, frame.begin() + BLOCK_SIZE);
+                std::fill(frame.begin() + FFT_SIZE, frame.end(), 0.0f);
+                kernel->fft.performRealOnlyForwardTransform(frame.data(), true);
+
+                float* newest = inputSpectra.data() + fdlPos * NUM_BINS * 2;
+                std::copy(frame.begin(), frame.begin() + NUM_BINS * 2, newest);
+
+                // Frequency-domain delay line: tail partition p meets input block (now - p)
+                std::fill(accum.begin(), accum.end(), 0.0f);
+                for (int p = 0; p < numParts; ++p)
+                {
+                    int slot = fdlPos - p;
+                    if (slot < 0) slot += numParts;
+
+                    const float* X = inputSpectra.data() + slot * NUM_BINS * 2;
+                    const float* H = kernel->tailSpectra.data() + p * NUM_BINS * 2;
+                    for (int b = 0; b < NUM_BINS; ++b)
+                    {
+                        const float xr = X[2 * b], xi = X[2 * b + 1];
+                        const float hr = H[2 * b], hi = H[2 * b + 1];
+                        accum[2 * b]     += xr * hr - xi * hi;
+                        accum[2 * b + 1] += xr * hi + xi * hr;
+                    }
+                }
+
+                // Restore conjugate-symmetric upper half for the real inverse
+                for (int b = 1; b < FFT_SIZE / 2; ++b)
+                {
+                    accum[2 * (FFT_SIZE - b)]     =  accum[2 * b];
+                    accum[2 * (FFT_SIZE - b) + 1] = -accum[2 * b + 1];
+                }
+                kernel->fft.performRealOnlyInverseTransform(accum.data());
+
+                std::copy(accum.begin() + BLOCK_SIZE, accum.begin() + FFT_SIZE, tailOut);
+
+                if (++fdlPos >= numParts) fdlPos = 0;
+            }
+
+            std::copy(currentBlock, currentBlock + BLOCK_SIZE, previousBlock);
+        }
+
+        std::shared_ptr<const Kernel> kernel;
+        std::vector<float> frame, accum, inputSpectra;
+        float history[2 * BLOCK_SIZE] = {};
+        float previousBlock[BLOCK_SIZE] = {};
+        float currentBlock[BLOCK_SIZE] = {};
+        float tailOut[BLOCK_SIZE] = {};
+        int historyPos = 0;
+        int blockPos = 0;
+        int fdlPos = 0;
+    };
+
+    // Message thread: queue a new engine (nullptr removes the IR)
+    void load(std::unique_ptr<Engine> engine)
+    {
+        std::unique_ptr<Engine> garbage;
+        {
+            const juce::SpinLock::ScopedLockType lock(swapLock);
+            garbage = std::move(retired);
+            std::swap(pending, engine);
+            hasPending = true;
+        }
+        // Previous unclaimed engine and retired engine are freed here, off the audio thread
+    }
+
+    // Audio thread: adopt a queued engine without blocking or freeing memory
+    void update()
+    {
+        const juce::SpinLock::ScopedTryLockType lock(swapLock);
+        if (lock.isLocked() && hasPending && retired == nullptr)
+        {
+            retired = std::move(active);
+            active = std::move(pending);
+            hasPending = false;
+        }
+    }
+
+    bool isActive() const { return active != nullptr; }
+    float process(float input) { return active->process(input); }
+
+    void probeState(StateProbe& probe) const
+    {
+        if (active != nullptr)
+            active->probeState(probe);
+    }
+
+private:
+    std::unique_ptr<Engine> active, pending, retired;
+    bool hasPending = false;
+    juce::SpinLock swapLock;
+};
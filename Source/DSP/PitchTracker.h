@@ -0,0 +1,170 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "StateProbe.h"
+
+//==============================================================================
+// PitchTracker: Incremental YIN on a decimated copy of the conditioned input
+// The difference function d(tau) is updated per decimated sample by adding
+// the newest term and removing the one leaving the window (O(maxLag)); the
+// CMND search runs once per hop. Fixed arrays, no allocation.
+//==============================================================================
+class PitchTracker
+{
+public:
+    void prepare(double sampleRate)
+    {
+        // Decimate to ~11-12 kHz: plenty for violin fundamentals (G3..~2 kHz)
+        factor = juce::jmax(1, static_cast<int>(sampleRate / TARGET_RATE));
+        decimatedRate = static_cast<float>(sampleRate) / static_cast<float>(factor);
+        minLag = juce::jmax(2, static_cast<int>(decimatedRate / MAX_FREQ));
+        maxLag = juce::jmin(MAX_LAG, static_cast<int>(decimatedRate / MIN_FREQ) + 1);
+
+        // Anti-alias lowpass ahead of the decimator (RBJ, Butterworth Q)
+        const float w0 = 2.0f * juce::MathConstants<float>::pi * 0.4f * decimatedRate / static_cast<float>(sampleRate);
+        const float alpha = std::sin(w0) / (2.0f * 0.7071f);
+        const float a0 = 1.0f + alpha;
+        lpB0 = (1.0f - std::cos(w0)) * 0.5f / a0;
+        lpB1 = (1.0f - std::cos(w0)) / a0;
+        lpB2 = lpB0;
+        lpA1 = -2.0f * std::cos(w0) / a0;
+        lpA2 = (1.0f - alpha) / a0;
+
+        reset();
+    }
+
+    void reset()
+    {
+        lpZ1 = lpZ2 = 0.0f;
+        std::fill(std::begin(ring), std::end(ring), 0.0f);
+        std::fill(std::begin(difference), std::end(difference), 0.0);
+        windowEnergy = 0.0;
+        ringPos = 0;
+        decimationPhase = 0;
+        hopCounter = 0;
+        voiced = false;
+        confidence = 0.0f;
+    }
+
+    void process(float input)
+    {
+        const float filtered = lpB0 * input + lpZ1;
+        lpZ1 = lpB1 * input - lpA1 * filtered + lpZ2;
+        lpZ2 = lpB2 * input - lpA2 * filtered;
+
+        if (++decimationPhase < factor)
+            return;
+        decimationPhase = 0;
+
+        push(filtered);
+        if (++hopCounter == HOP)
+        {
+            hopCounter = 0;
+            analyse();
+        }
+    }
+
+    bool isVoiced() const { return voiced; }
+    float getFrequency() const { return frequency; }     // Last voiced estimate, Hz
+    float getConfidence() const { return confidence; }   // 1 - CMND at the chosen lag
+
+    void probeState(StateProbe& probe) const
+    {
+        probe.visit("lpZ1", lpZ1);
+        probe.visit("lpZ2", lpZ2);
+        probe.visit("ring", ring);
+        probe.visit("difference", difference);
+        probe.visit("windowEnergy", windowEnergy);
+    }
+
+private:
+    static constexpr double TARGET_RATE = 11025.0;
+    static constexpr float MIN_FREQ = 130.0f;            // Below G3 with retuning headroom
+    static constexpr float MAX_FREQ = 2000.0f;
+    static constexpr int WINDOW = 128;                   // Integration window, decimated samples
+    static constexpr int MAX_LAG = 96;
+    static constexpr int RING_SIZE = 256;                // >= WINDOW + MAX_LAG + 1, power of two
+    static constexpr int HOP = 32;                       // ~3 ms at the decimated rate
+    static constexpr float THRESHOLD = 0.15f;            // YIN absolute threshold
+    static constexpr double MIN_ENERGY = WINDOW * 1.0e-5; // ~-50 dBFS RMS gate
+
+    float at(int offset) const { return ring[(ringPos - offset) & (RING_SIZE - 1)]; }
+
+    // Slide the window one sample: add the newest d(tau) terms, drop the oldest
+    void push(float x)
+    {
+        ring[ringPos] = x;
+
+        const float leaving = at(WINDOW);
+        for (int tau = 1; tau <= maxLag; ++tau)
+        {
+            const float added = x - at(tau);
+            const float removed = leaving - at(WINDOW + tau);
+            difference[tau] += static_cast<double>(added * added) - static_cast<double>(removed * removed);
+        }
+        windowEnergy += static_cast<double>(x * x) - static_cast<double>(leaving * leaving);
+
+        ringPos = (ringPos + 1) & (RING_SIZE - 1);
+    }
+
+    void analyse()
+    {
+        if (windowEnergy < MIN_ENERGY)
+        {
+            voiced = false;
+            confidence = 0.0f;
+            return;
+        }
+
+        // Cumulative mean normalized difference; first dip under the threshold
+        double runningSum = 0.0;
+        float cmnd[MAX_LAG + 1];
+        cmnd[0] = 1.0f;
+        int best = -1;
+        for (int tau = 1; tau <= maxLag; ++tau)
+        {
+            runningSum += difference[tau];
+            cmnd[tau] = runningSum > 0.0 ? static_cast<float>(difference[tau] * tau / runningSum) : 1.0f;
+
+            if (best < 0 && tau > minLag && cmnd[tau - 1] < THRESHOLD && cmnd[tau] >= cmnd[tau - 1])
+                best = tau - 1;
+        }
+
+        if (best < 0)
+        {
+            voiced = false;
+            confidence = 0.0f;
+            return;
+        }
+
+        // Parabolic interpolation on the raw difference function (less biased than CMND)
+        float lag = static_cast<float>(best);
+        if (best > 1 && best < maxLag)
+        {
+            const double a = difference[best - 1], b = difference[best], c = difference[best + 1];
+            const double denom = a - 2.0 * b + c;
+            if (denom > 0.0)
+                lag += static_cast<float>(0.5 * (a - c) / denom);
+        }
+
+        voiced = true;
+        confidence = 1.0f - cmnd[best];
+        frequency = decimatedRate / lag;
+    }
+
+    int factor = 4;
+    float decimatedRate = 11025.0f;
+    int minLag = 2, maxLag = MAX_LAG;
+
+    float lpB0 = 1.0f, lpB1 = 0.0f, lpB2 = 0.0f, lpA1 = 0.0f, lpA2 = 0.0f;
+    float lpZ1 = 0.0f, lpZ2 = 0.0f;
+
+    float ring[RING_SIZE] = {};
+    double difference[MAX_LAG + 1] = {};
+    double windowEnergy = 0.0;
+    int ringPos = 0, decimationPhase = 0, hopCounter = 0;
+
+    bool voiced = false;
+    float frequency = 440.0f;
+    float confidence = 0.0f;
+};
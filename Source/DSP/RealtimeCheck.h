@@ -0,0 +1,42 @@
+#pragma once
+
+//==============================================================================
+// RealtimeCheck: marks the code that must never allocate, lock, sleep or
+// touch files. Compiles to nothing unless ABYSS_RT_CHECK is defined; in that
+// test-build mode the section name is kept per thread, and the hooks in
+// Tools/RealtimeCheck report every such call made while one is open.
+//==============================================================================
+
+#ifndef ABYSS_RT_CHECK
+ #define ABYSS_RT_CHECK 0
+#endif
+
+#if ABYSS_RT_CHECK
+
+namespace AbyssRT
+{
+
+// Innermost open real-time section on this thread (nullptr: none)
+inline thread_local const char* currentSection = nullptr;
+
+class ScopedRealtimeSection
+{
+public:
+    explicit ScopedRealtimeSection(const char* name) noexcept : previous(currentSection) { currentSection = name; }
+    ~ScopedRealtimeSection() noexcept { currentSection = previous; }
+
+    ScopedRealtimeSection(const ScopedRealtimeSection&) = delete;
+    ScopedRealtimeSection& operator=(const ScopedRealtimeSection&) = delete;
+
+private:
+    const char* previous;
+};
+
+} // namespace AbyssRT
+
+ // Open until the end of the enclosing scope
+ #define ABYSS_REALTIME_SECTION(name) const AbyssRT::ScopedRealtimeSection abyssRealtimeSection { name }
+
+#else
+ #define ABYSS_REALTIME_SECTION(name)
+#endif
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "AbyssFDNReverb.h"
+#include "DattorroPlate.h"
+#include "HybridTailReverb.h"
+#include "SmoothedParameters.h"
+
+//==============================================================================
+// Reverb engines: stereo wrappers sharing one compile-time interface,
+//   setParameters(const SmoothedParameters&)
+//   process(inL, inR, outL, outR)
+// processBlock picks one per block and instantiates the sample loop for it,
+// so engine selection costs no per-sample virtual call or branch.
+//==============================================================================
+struct FDNReverbEngine
+{
+    AbyssFDNReverb& left;
+    AbyssFDNReverb& right;
+    HybridTailReverb& tail;
+    float shimmerRatio;
+
+    void setParameters(const SmoothedParameters& p)
+    {
+        left.setParameters(p.reverbDecay, p.reverbDampHigh, p.reverbDampLow,
+                           p.reverbModDepth, p.reverbModRate, p.detuneAmount);
+        right.setParameters(p.reverbDecay, p.reverbDampHigh, p.reverbDampLow,
+                            p.reverbModDepth, p.reverbModRate, p.detuneAmount);
+        left.setShimmer(p.shimmer, shimmerRatio);
+        right.setShimmer(p.shimmer, shimmerRatio);
+    }
+
+    void process(float inL, float inR, float& outL, float& outR)
+    {
+        tail.process(left, right, inL, inR, outL, outR);
+    }
+};
+
+struct PlateReverbEngine
+{
+    DattorroPlate& plate;
+
+    void setParameters(const SmoothedParameters& p)
+    {
+        plate.setParameters(p.reverbDecay, p.reverbDampHigh, p.reverbDampLow,
+                            p.reverbModDepth, p.reverbModRate, p.detuneAmount);
+    }
+
+    void process(float inL, float inR, float& outL, float& outR)
+    {
+        plate.process(inL, inR, outL, outR);
+    }
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "StateProbe.h"
+
+#include <cmath>
+
+//==============================================================================
+// SmoothedParameters: Per-sample smoothing of all continuous parameters
+//==============================================================================
+struct SmoothedParameters
+{
+    static constexpr int NUM_PARAMS = 22;
+
+    // Violin input conditioning
+    float piezoCorrect = 0.5f, bodyResonance = 0.5f, brightness = 0.5f, bowSensitivity = 0.5f;
+    float sympathetic = 0.0f;
+    // Reverb
+    float reverbDecay = 6.0f, reverbDampHigh = 0.7f, reverbDampLow = 0.3f;
+    float reverbModDepth = 0.5f, reverbModRate = 0.3f, detuneAmount = 0.0f;
+    float diffusion = 0.5f, preDelay = 0.0f, shimmer = 0.0f;
+    // Delay
+    float delayTime = 400.0f, delayFeedback = 0.5f;
+    float vanishRate = 0.3f, degradeAmount = 0.3f, driftAmount = 2.0f;
+    // Mix
+    float reverbMix = 0.4f, delayMix = 0.3f, masterMix = 0.5f;
+
+    void reset(float sampleRate)
+    {
+        // ~10ms ramp time for smooth transitions
+        smoothingCoeff = std::exp(-1.0f / (sampleRate * 0.01f));
+    }
+
+    void smooth(const float* rawTargets)
+    {
+        // Order must match parameter indices
+        float* targets[] = {
+            &piezoCorrect, &bodyResonance, &brightness, &bowSensitivity,
+            &reverbDecay, &reverbDampHigh, &reverbDampLow, &reverbModDepth, &reverbModRate, &detuneAmount,
+            &delayTime, &delayFeedback, &vanishRate, &degradeAmount, &driftAmount,
+            &reverbMix, &delayMix, &masterMix,
+            &diffusion, &preDelay, &sympathetic, &shimmer
+        };
+
+        for (size_t i = 0; i < NUM_PARAMS; ++i)
+        {
+            *targets[i] += (rawTargets[i] - *targets[i]) * (1.0f - smoothingCoeff);
+        }
+    }
+
+    void probeState(StateProbe& probe) const
+    {
+        probe.visit("piezoCorrect", piezoCorrect);
+        probe.visit("bodyResonance", bodyResonance);
+        probe.visit("brightness", brightness);
+        probe.visit("bowSensitivity", bowSensitivity);
+        probe.visit("reverbDecay", reverbDecay);
+        probe.visit("reverbDampHigh", reverbDampHigh);
+        probe.visit("reverbDampLow", reverbDampLow);
+        probe.visit("reverbModDepth", reverbModDepth);
+        probe.visit("reverbModRate", reverbModRate);
+        probe.visit("detuneAmount", detuneAmount);
+        probe.visit("delayTime", delayTime);
+        probe.visit("delayFeedback", delayFeedback);
+        probe.visit("vanishRate", vanishRate);
+        probe.visit("degradeAmount", degradeAmount);
+        probe.visit("driftAmount", driftAmount);
+        probe.visit("reverbMix", reverbMix);
+        probe.visit("delayMix", delayMix);
+        probe.visit("masterMix", masterMix);
+        probe.visit("diffusion", diffusion);
+        probe.visit("preDelay", preDelay);
+        probe.visit("sympathetic", sympathetic);
+        probe.visit("shimmer", shimmer);
+    }
+
+private:
+    float smoothingCoeff = 0.999f;
+};
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "StateProbe.h"
+
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// SpectralFreeze: Magnitude snapshot of the reverb output, resynthesised
+// with random phase by windowed overlap-add. Cost per sample depends only on
+// FFT size and hop, never on decay time. FFT twiddles, window and the phase
+// table are built in prepare().
+//==============================================================================
+class SpectralFreeze
+{
+public:
+    static constexpr int FFT_ORDER = 12;
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+    static constexpr int NUM_BINS = FFT_SIZE / 2 + 1;
+
+    // Distinct seeds per channel give decorrelated (wide) phases
+    void prepare(double sampleRate, int hopSize, uint32_t seed)
+    {
+        fft = std::make_unique<juce::dsp::FFT>(FFT_ORDER);
+        randomState = seed | 1u;
+
+        // Periodic Hann: analysis and synthesis window
+        window.resize(FFT_SIZE);
+        for (int n = 0; n < FFT_SIZE; ++n)
+            window[static_cast<size_t>(n)] = 0.5f - 0.5f * std::cos(2.0f * juce::MathConstants<float>::pi
+                                                                    * static_cast<float>(n) / static_cast<float>(FFT_SIZE));
+
+        for (int i = 0; i < PHASE_TABLE_SIZE; ++i)
+        {
+            const float phase = 2.0f * juce::MathConstants<float>::pi * static_cast<float>(i) / static_cast<float>(PHASE_TABLE_SIZE);
+            cosTable[i] = std::cos(phase);
+            sinTable[i] = std::sin(phase);
+        }
+
+        history.assign(FFT_SIZE, 0.0f);
+        overlap.assign(FFT_SIZE, 0.0f);
+        frame.assign(2 * FFT_SIZE, 0.0f);
+        magnitudes.assign(NUM_BINS, 0.0f);
+        fadeStep = 1.0f / static_cast<float>(sampleRate * FADE_SECONDS);
+
+        hop = 0;
+        setHop(hopSize);
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill(history.begin(), history.end(), 0.0f);
+        std::fill(overlap.begin(), overlap.end(), 0.0f);
+        historyPos = overlapPos = 0;
+        hopCountdown = 0;
+        frozen = false;
+        fade = 0.0f;
+    }
+
+    // Smaller hop = more overlap = smoother pad, one inverse FFT per hop
+    // Safe while frozen: frames already in the overlap keep their own gain and
+    // finish at the old spacing while new ones start at the new spacing
+    void setHop(int hopSize)
+    {
+        hopSize = juce::jlimit(FFT_SIZE / 16, FFT_SIZE / 2, hopSize);
+        if (hopSize == hop)
+            return;
+        hop = hopSize;
+
+        // Random-phase frames add in power: Hann^2 averages 3/8 per frame, twice
+        const float overlapFactor = static_cast<float>(FFT_SIZE / hop);
+        synthesisGain = 8.0f / (3.0f * std::sqrt(overlapFactor));
+        hopCountdown = juce::jmin(hopCountdown, hop);
+    }
+
+    // Rising edge captures the last FFT_SIZE samples of the live signal
+    void setFrozen(bool shouldFreeze)
+    {
+        if (shouldFreeze && ! frozen)
+            capture();
+        frozen = shouldFreeze;
+    }
+
+    // Live input in, live/frozen crossfade out
+    float process(float input)
+    {
+        history[static_cast<size_t>(historyPos)] = input;
+        historyPos = (historyPos + 1) & (FFT_SIZE - 1);
+
+        if (! frozen && fade == 0.0f)
+            return input;
+
+        if (--hopCountdown <= 0)
+        {
+            hopCountdown = hop;
+            synthesiseFrame();
+        }
+
+        const float resynthesised = overlap[static_cast<size_t>(overlapPos)];
+        overlap[static_cast<size_t>(overlapPos)] = 0.0f;
+        overlapPos = (overlapPos + 1) & (FFT_SIZE - 1);
+
+        fade = frozen ? juce::jmin(1.0f, fade + fadeStep) : juce::jmax(0.0f, fade - fadeStep);
+        if (fade == 0.0f)
+        {
+            std::fill(overlap.begin(), overlap.end(), 0.0f);   // Released: next freeze starts clean
+            hopCountdown = 0;
+        }
+
+        return input + fade * (resynthesised - input);
+    }
+
+    void probeState(StateProbe& probe) const
+    {
+        probe.visit("history", history);
+        probe.visit("overlap", overlap);
+        probe.visit("magnitudes", magnitudes);
+    }
+
+private:
+    static constexpr int PHASE_TABLE_SIZE = 1024;
+    static constexpr double FADE_SECONDS = 0.05;
+
+    void capture()
+    {
+        for (int n = 0; n < FFT_SIZE; ++n)
+            frame[static_cast<size_t>(n)] = history[static_cast<size_t>((historyPos + n) & (FFT_SIZE - 1))]
+                                          * window[static_cast<size_t>(n)];
+        std::fill(frame.begin() + FFT_SIZE, frame.end(), 0.0f);
+
+        fft->performFrequencyOnlyForwardTransform(frame.data());
+        std::copy(frame.begin(), frame.begin() + NUM_BINS, magnitudes.begin());
+    }
+
+    void synthesiseFrame()
+    {
+        // Held magnitudes, fresh random phases; DC and Nyquist stay real
+        frame[0] = magnitudes[0];
+        frame[1] = 0.0f;
+        for (int k = 1; k < NUM_BINS - 1; ++k)
+        {
+            randomState ^= randomState << 13;
+            randomState ^= randomState >> 17;
+            randomState ^= randomState << 5;
+            const int phase = static_cast<int>(randomState & (PHASE_TABLE_SIZE - 1));
+
+            const float re = magnitudes[static_cast<size_t>(k)] * cosTable[phase];
+            const float im = magnitudes[static_cast<size_t>(k)] * sinTable[phase];
+            frame[static_cast<size_t>(2 * k)] = re;
+            frame[static_cast<size_t>(2 * k + 1)] = im;
+            frame[static_cast<size_t>(2 * (FFT_SIZE - k))] = re;        // Conjugate-symmetric upper half
+            frame[static_cast<size_t>(2 * (FFT_SIZE - k) + 1)] = -im;
+        }
+        frame[static_cast<size_t>(2 * (NUM_BINS - 1))] = magnitudes[NUM_BINS - 1];
+        frame[static_cast<size_t>(2 * (NUM_BINS - 1) + 1)] = 0.0f;
+
+        fft->performRealOnlyInverseTransform(frame.data());
+
+        for (int n = 0; n < FFT_SIZE; ++n)
+            overlap[static_cast<size_t>((overlapPos + n) & (FFT_SIZE - 1))]
+                += frame[static_cast<size_t>(n)] * window[static_cast<size_t>(n)] * synthesisGain;
+    }
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> window, history, overlap, frame, magnitudes;
+    float cosTable[PHASE_TABLE_SIZE] = {};
+    float sinTable[PHASE_TABLE_SIZE] = {};
+
+    int historyPos = 0, overlapPos = 0;
+    int hop = 0, hopCountdown = 0;
+    float synthesisGain = 1.0f;
+    bool frozen = false;
+    float fade = 0.0f, fadeStep = 0.001f;
+    uint32_t randomState = 0x9E3779B9u;
+};
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+ #include <x86intrin.h>
+#endif
+
+//==============================================================================
+// StageProfiler: where the audio thread's time goes, stage by stage
+// The sample loop calls lap(stage) at the end of each stage; a lap charges
+// the cycles since the previous lap to that stage, so one counter read per
+// boundary splits the whole block with nothing left unattributed. Totals are
+// kept in a per-block accumulator and published with relaxed atomic adds at
+// the end of the block; readers (editor, tools) take snapshots from any
+// thread and difference them. A snapshot is not atomic across stages; over
+// a few hundred blocks the skew is negligible.
+//
+// Each lap's own counter read would otherwise be charged to the stage it
+// closes, inflating the short per-sample stages. The cheapest back-to-back
+// read, measured once at construction, is taken off every lap and booked as
+// profiler overhead instead: it still counts towards the block's time, but
+// not towards any stage.
+//
+// Compiled in unless ABYSS_STAGE_PROFILER is 0, off until setEnabled(true).
+// Disabled cost: one predictable branch per lap.
+//==============================================================================
+
+#ifndef ABYSS_STAGE_PROFILER
+ #define ABYSS_STAGE_PROFILER 1
+#endif
+
+class StageProfiler
+{
+public:
+    enum Stage
+    {
+        setup,          // processBlock up to the sample loop (parameter fetch, engine switches)
+        parameters,     // Per-sample smoothing and module parameter updates
+        conditioning,   // Howl guard and input conditioning
+        envelope,       // Envelope followers, pitch tracking, sympathetic tuning
+        sympathetic,    // Sympathetic string bank
+        delay,          // Vanishing delay and pre-delay taps
+        reverb,         // Diffusers, reverb engine, spectral freeze
+        dcBlock,
+        mix,            // Wet sum and dry/wet mix
+        numStages
+    };
+
+    StageProfiler() noexcept : lapOverhead(calibrateLapOverhead()) {}
+
+    static const char* getStageName(int stage)
+    {
+        static const char* const names[numStages] =
+            { "setup", "parameters", "conditioning", "envelope", "sympathetic", "delay", "reverb", "dc block", "mix" };
+        return stage >= 0 && stage < numStages ? names[stage] : "";
+    }
+
+    // Cycle counter where the CPU has a cheap one (x86 TSC, ARM virtual counter), steady_clock otherwise
+    static uint64_t readCounter() noexcept
+    {
+       #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+       #elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+       #elif defined(__aarch64__)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+       #else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+       #endif
+    }
+
+    struct Snapshot
+    {
+        uint64_t counts[numStages] {};
+        uint64_t overhead = 0;      // Counter reads taken off the stages
+        uint64_t blocks = 0;
+        uint64_t samples = 0;
+        double seconds = 0.0;       // Wall time spent in profiled blocks
+
+        uint64_t getTotalCount() const
+        {
+            uint64_t total = overhead;
+            for (auto c : counts)
+                total += c;
+            return total;
+        }
+
+        // Activity between an earlier snapshot and this one
+        Snapshot operator-(const Snapshot& earlier) const
+        {
+            Snapshot d;
+            for (int i = 0; i < numStages; ++i)
+                d.counts[i] = counts[i] - earlier.counts[i];
+            d.overhead = overhead - earlier.overhead;
+            d.blocks = blocks - earlier.blocks;
+            d.samples = samples - earlier.samples;
+            d.seconds = seconds - earlier.seconds;
+            return d;
+        }
+
+        // Wall time attributed to a stage: its share of the counts times the profiled time
+        double getStageSeconds(int stage) const
+        {
+            const uint64_t total = getTotalCount();
+            return total > 0 ? seconds * static_cast<double>(counts[stage]) / static_cast<double>(total) : 0.0;
+        }
+    };
+
+    void setEnabled(bool shouldBeEnabled) noexcept { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    Snapshot getSnapshot() const noexcept
+    {
+        Snapshot s;
+        for (int i = 0; i < numStages; ++i)
+            s.counts[i] = totals[i].load(std::memory_order_relaxed);
+        s.overhead = overhead.load(std::memory_order_relaxed);
+        s.blocks = blocks.load(std::memory_order_relaxed);
+        s.samples = samples.load(std::memory_order_relaxed);
+        s.seconds = static_cast<double>(nanoseconds.load(std::memory_order_relaxed)) * 1.0e-9;
+        return s;
+    }
+
+    //==============================================================================
+    // Audio-thread side: one per processBlock, published when it goes out of scope
+   #if ABYSS_STAGE_PROFILER
+    class Block
+    {
+    public:
+        explicit Block(StageProfiler& p) noexcept
+            : profiler(p), active(p.isEnabled()), lapOverhead(p.lapOverhead)
+        {
+            if (active)
+            {
+                startTime = std::chrono::steady_clock::now();
+                last = readCounter();
+            }
+        }
+
+        ~Block()
+        {
+            if (! active)
+                return;
+
+            const auto elapsed = std::chrono::steady_clock::now() - startTime;
+            for (int i = 0; i < numStages; ++i)
+                profiler.totals[i].fetch_add(counts[i], std::memory_order_relaxed);
+            profiler.overhead.fetch_add(overhead, std::memory_order_relaxed);
+            profiler.samples.fetch_add(numSamples, std::memory_order_relaxed);
+            profiler.nanoseconds.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                                           std::memory_order_relaxed);
+            profiler.blocks.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Block(const Block&) = delete;
+        Block& operator=(const Block&) = delete;
+
+        // Charges everything since the previous lap to 'stage', less the lap's own read
+        void lap(Stage stage) noexcept
+        {
+            if (! active)
+                return;
+            const uint64_t now = readCounter();
+            const uint64_t spent = now - last;
+            const uint64_t read = spent < lapOverhead ? spent : lapOverhead;
+            counts[stage] += spent - read;
+            overhead += read;
+            last = now;
+        }
+
+        void addSamples(int n) noexcept { numSamples += static_cast<uint64_t>(n); }
+
+    private:
+        StageProfiler& profiler;
+        const bool active;
+        const uint64_t lapOverhead;
+        uint64_t counts[numStages] {};
+        uint64_t overhead = 0;
+        uint64_t last = 0;
+        uint64_t numSamples = 0;
+        std::chrono::steady_clock::time_point startTime;
+    };
+   #else
+    class Block
+    {
+    public:
+        explicit Block(StageProfiler&) noexcept {}
+        void lap(Stage) noexcept {}
+        void addSamples(int) noexcept {}
+    };
+   #endif
+
+private:
+    // Cheapest of a few hundred back-to-back reads: a lower bound, so stages are never undercharged
+    static uint64_t calibrateLapOverhead() noexcept
+    {
+        uint64_t best = ~uint64_t(0);
+        for (int i = 0; i < 256; ++i)
+        {
+            const uint64_t a = readCounter();
+            const uint64_t b = readCounter();
+            if (b - a < best)
+                best = b - a;
+        }
+        return best;
+    }
+
+    const uint64_t lapOverhead;
+    std::atomic<bool> enabled { false };
+    std::atomic<uint64_t> totals[numStages] {};
+    std::atomic<uint64_t> overhead { 0 };
+    std::atomic<uint64_t> blocks { 0 }, samples { 0 }, nanoseconds { 0 };
+};
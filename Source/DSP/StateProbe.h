@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+//==============================================================================
+// StateProbe: read-only walk over the persistent signal state of the modules
+// Each stateful module lists its filter memories and buffers in
+// probeState(StateProbe&) const (coefficients and oscillators are left out);
+// owners call beginModule() with their own name for each member they forward.
+// Diagnostics only: call between blocks, on the thread that runs them.
+//==============================================================================
+class StateProbe
+{
+public:
+    virtual ~StateProbe() = default;
+
+    virtual void beginModule(const char* name) = 0;
+    virtual void visit(const char* field, const float* values, size_t count) = 0;
+    virtual void visit(const char* field, const double* values, size_t count) = 0;
+
+    void visit(const char* field, const float& value) { visit(field, &value, 1); }
+    void visit(const char* field, const double& value) { visit(field, &value, 1); }
+    void visit(const char* field, const std::vector<float>& values) { visit(field, values.data(), values.size()); }
+
+    template <size_t N>
+    void visit(const char* field, const float (&values)[N]) { visit(field, values, N); }
+
+    template <size_t N>
+    void visit(const char* field, const double (&values)[N]) { visit(field, values, N); }
+};
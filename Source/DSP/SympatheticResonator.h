@@ -0,0 +1,141 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "StateProbe.h"
+
+#include <vector>
+
+//==============================================================================
+// SympatheticResonator: Open-string comb bank (G3/D4/A4/E5) after conditioning
+// Each feedback comb rings at its string's full harmonic series; an in-loop
+// one-pole loss filter lets upper harmonics die first, like a real string.
+// L and R lanes sit side by side (SoA, power-of-two rings, shared write
+// index) so the update loop runs 8 combs as one vectorizable batch.
+//==============================================================================
+class SympatheticResonator
+{
+public:
+    static constexpr int NUM_STRINGS = 4;
+    static constexpr int NUM_COMBS = NUM_STRINGS * 2;   // Lanes 0-3 left, 4-7 right
+
+    void prepare(double sampleRate)
+    {
+        sr = sampleRate;
+
+        // One-pole loss filter; setTuning() takes its phase delay off the comb length
+        dampCoeff = std::exp(-2.0f * juce::MathConstants<float>::pi * DAMP_FREQ / static_cast<float>(sr));
+
+        // Rings sized for the lowest retuned string
+        ringSize = juce::nextPowerOfTwo(static_cast<int>(sr / (OPEN_STRINGS[0] * MIN_TUNING)) + 4);
+        mask = ringSize - 1;
+        rings.assign(static_cast<size_t>(ringSize * NUM_COMBS), 0.0f);
+        writePos = 0;
+
+        tuning = 0.0f;
+        setTuning(1.0f);
+        clear();
+    }
+
+    // Transpose every string by 'ratio' (pitch following); control rate only
+    void setTuning(float ratio)
+    {
+        ratio = juce::jlimit(MIN_TUNING, MAX_TUNING, ratio);
+        if (ratio == tuning)
+            return;
+        tuning = ratio;
+
+        const float lossDelay = dampCoeff / (1.0f - dampCoeff);
+        for (int c = 0; c < NUM_COMBS; ++c)
+        {
+            const int string = c % NUM_STRINGS;
+            const float freq = OPEN_STRINGS[string] * ratio * (c < NUM_STRINGS ? 1.0f : STEREO_DETUNE);
+            delays[c] = static_cast<float>(sr) / freq - lossDelay;
+
+            // Loop gain from the string's RT60; input scaled for unity gain at resonance
+            feedback[c] = std::pow(10.0f, -3.0f * delays[c] / (static_cast<float>(sr) * RING_TIMES[string]));
+            inputGain[c] = 1.0f - feedback[c];
+        }
+    }
+
+    // Semitones from 'frequency' to the nearest octave of the nearest open string
+    static float intervalToNearestString(float frequency)
+    {
+        float nearest = 12.0f;
+        for (float open : OPEN_STRINGS)
+        {
+            float semitones = 12.0f * std::log2(frequency / open);
+            semitones -= 12.0f * std::round(semitones / 12.0f);
+            if (std::abs(semitones) < std::abs(nearest))
+                nearest = semitones;
+        }
+        return nearest;
+    }
+
+    void process(float inputL, float inputR, float& outputL, float& outputR)
+    {
+        alignas(16) float delayed[NUM_COMBS];
+        alignas(16) float excite[NUM_COMBS];
+
+        // Fractional reads (linear interpolation) from each ring
+        for (int c = 0; c < NUM_COMBS; ++c)
+        {
+            const float readPos = static_cast<float>(writePos + ringSize) - delays[c];
+            const int index = static_cast<int>(readPos);
+            const float frac = readPos - static_cast<float>(index);
+            const float* ring = rings.data() + c * ringSize;
+            const float a = ring[index & mask];
+            const float b = ring[(index + 1) & mask];
+            delayed[c] = a + frac * (b - a);
+            excite[c] = c < NUM_STRINGS ? inputL : inputR;
+        }
+
+        // Batched loss filter + comb update
+        alignas(16) float out[NUM_COMBS];
+        for (int c = 0; c < NUM_COMBS; ++c)
+        {
+            lossState[c] = delayed[c] + dampCoeff * (lossState[c] - delayed[c]);
+            out[c] = inputGain[c] * excite[c] + feedback[c] * lossState[c];
+        }
+
+        outputL = 0.0f;
+        outputR = 0.0f;
+        for (int c = 0; c < NUM_COMBS; ++c)
+        {
+            rings[static_cast<size_t>(c * ringSize + writePos)] = out[c];
+            (c < NUM_STRINGS ? outputL : outputR) += out[c];
+        }
+
+        writePos = (writePos + 1) & mask;
+    }
+
+    void clear()
+    {
+        std::fill(rings.begin(), rings.end(), 0.0f);
+        std::fill(std::begin(lossState), std::end(lossState), 0.0f);
+    }
+
+    void probeState(StateProbe& probe) const
+    {
+        probe.visit("rings", rings);
+        probe.visit("lossState", lossState);
+    }
+
+private:
+    static constexpr float OPEN_STRINGS[NUM_STRINGS] = { 196.00f, 293.66f, 440.00f, 659.26f };
+    static constexpr float RING_TIMES[NUM_STRINGS] = { 2.4f, 2.0f, 1.7f, 1.4f };   // RT60, seconds
+    static constexpr float STEREO_DETUNE = 1.0015f;   // ~2.6 cents, slow beating across L/R
+    static constexpr float DAMP_FREQ = 4000.0f;
+    static constexpr float MIN_TUNING = 0.7071f;   // -6 semitones
+    static constexpr float MAX_TUNING = 1.4142f;   // +6 semitones
+
+    double sr = 44100.0;
+    std::vector<float> rings;
+    int ringSize = 1, mask = 0, writePos = 0;
+    float dampCoeff = 0.5f;
+    float tuning = 1.0f;
+
+    alignas(16) float delays[NUM_COMBS] = {};
+    alignas(16) float feedback[NUM_COMBS] = {};
+    alignas(16) float inputGain[NUM_COMBS] = {};
+    alignas(16) float lossState[NUM_COMBS] = {};
+};
@@ -0,0 +1,50 @@
+#include "TailConvolver.h"
+
+//==============================================================================
+TailConvolver::Kernel::Kernel(const float* ir, int irLength) : length(irLength)
+{
+    const int orders[NUM_SEGMENTS] = { 9, 11, 13, MAX_FFT_ORDER }; // FFT = 2 * blockSize
+    const int lags[NUM_SEGMENTS] = { 1, 2, 2, MAX_LAG };
+
+    int start = HEAD_SIZE;
+    size_t totalSpectra = 0;
+    for (int s = 0; s < NUM_SEGMENTS; ++s)
+    {
+        Segment& seg = segments[s];
+        seg.blockSize = 1 << (orders[s] - 1);
+        seg.numBins = seg.blockSize + 1;
+        seg.lag = lags[s];
+        ffts[s] = std::make_unique<juce::dsp::FFT>(orders[s]);
+
+        // Partitions up to where the next segment takes over (last one runs to the end)
+        int end = (s + 1 < NUM_SEGMENTS) ? (1 << (orders[s + 1] - 1)) * lags[s + 1] : length;
+        end = juce::jmin(end, length);
+        seg.numPartitions = juce::jmax(0, (end - start + seg.blockSize - 1) / seg.blockSize);
+        seg.spectraOffset = totalSpectra;
+        totalSpectra += static_cast<size_t>(seg.numPartitions * seg.numBins * 2);
+
+        if (seg.numPartitions > 0)
+            start += seg.numPartitions * seg.blockSize;
+    }
+
+    spectra.resize(totalSpectra, 0.0f);
+
+    start = HEAD_SIZE;
+    for (int s = 0; s < NUM_SEGMENTS; ++s)
+    {
+        const Segment& seg = segments[s];
+        std::vector<float> frame(static_cast<size_t>(4 * seg.blockSize));
+        for (int p = 0; p < seg.numPartitions; ++p)
+        {
+            std::fill(frame.begin(), frame.end(), 0.0f);
+            const int count = juce::jmax(0, juce::jmin(seg.blockSize, length - start));
+            std::copy(ir + start, ir + start + count, frame.begin());
+            start += seg.blockSize;
+
+            ffts[s]->performRealOnlyForwardTransform(frame.data(), true);
+            std::copy(frame.begin(), frame.begin() + seg.numBins * 2,
+                      spectra.begin() + static_cast<std::ptrdiff_t>(seg.spectraOffset)
+                                      + p * seg.numBins * 2);
+        }
+    }
+}
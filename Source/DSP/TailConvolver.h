@@ -0,0 +1,205 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "StateProbe.h"
+
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// TailConvolver: Non-uniform partitioned convolution for long, captured tails
+// Segments of growing partition size (256 / 1024 / 4096 / 8192), each a
+// uniformly-partitioned frequency-domain delay line. Small segments compute
+// at their block boundary; large ones start two blocks late so their
+// spectral multiply-adds are spread evenly across the block.
+// Partitions stop at 8192: JUCE's fallback FFT (Linux / Windows) allocates
+// its scratch on the heap above 256 KB, i.e. from 32768 points up.
+// The first 256 taps are not rendered: FDN impulse responses are silent for
+// at least the shortest delay line.
+//==============================================================================
+class TailConvolver
+{
+public:
+    static constexpr int NUM_SEGMENTS = 4;
+    static constexpr int HEAD_SIZE = 256;
+    static constexpr int MAX_FFT_ORDER = 14;             // Largest partition: 8192 samples
+    static constexpr int MAX_LAG = 2;
+
+    struct Segment
+    {
+        int blockSize = 0;
+        int numBins = 0;
+        int numPartitions = 0;
+        int lag = 1;              // Offset in blocks: 1 = compute at boundary, 2 = spread
+        size_t spectraOffset = 0;
+    };
+
+    // Immutable partition spectra, shared between channels
+    struct Kernel
+    {
+        Kernel(const float* ir, int irLength);
+
+        int length = 0;
+        Segment segments[NUM_SEGMENTS];
+        std::unique_ptr<juce::dsp::FFT> ffts[NUM_SEGMENTS];
+        std::vector<float> spectra;
+    };
+
+    // Per-channel convolution state, allocated together with its kernel
+    class Engine
+    {
+    public:
+        explicit Engine(std::shared_ptr<const Kernel> k) : kernel(std::move(k))
+        {
+            for (int s = 0; s < NUM_SEGMENTS; ++s)
+            {
+                const Segment& seg = kernel->segments[s];
+                State& st = states[s];
+                const size_t S = static_cast<size_t>(seg.blockSize);
+                st.previous.assign(S, 0.0f);
+                st.current.assign(S, 0.0f);
+                st.output.assign(S, 0.0f);
+                st.frame.assign(4 * S, 0.0f);
+                st.accum.assign(4 * S, 0.0f);
+                st.fdl.assign(static_cast<size_t>(juce::jmax(1, seg.numPartitions) * seg.numBins * 2), 0.0f);
+
+                // Spread the multiply-adds of a lag-2 segment evenly over its block
+                const int totalWork = seg.numPartitions * seg.numBins;
+                st.workPerSample = (totalWork + seg.blockSize - 1) / seg.blockSize;
+            }
+        }
+
+        float process(float input)
+        {
+            float output = 0.0f;
+
+            for (int s = 0; s < NUM_SEGMENTS; ++s)
+            {
+                const Segment& seg = kernel->segments[s];
+                if (seg.numPartitions == 0)
+                    continue;
+
+                State& st = states[s];
+                const int pos = static_cast<int>(sampleCount & static_cast<uint32_t>(seg.blockSize - 1));
+                st.current[static_cast<size_t>(pos)] = input;
+                output += st.output[static_cast<size_t>(pos)];
+
+                if (seg.lag > 1)
+                    multiplyAdd(s, st.workPerSample);
+
+                if (pos == seg.blockSize - 1)
+                    blockBoundary(s);
+            }
+
+            ++sampleCount;
+            return output;
+        }
+
+        void probeState(StateProbe& probe) const
+        {
+            for (const auto& st : states)
+            {
+                probe.visit("previous", st.previous);
+                probe.visit("current", st.current);
+                probe.visit("output", st.output);
+                probe.visit("accum", st.accum);
+                probe.visit("fdl", st.fdl);
+            }
+        }
+
+    private:
+        struct State
+        {
+            std::vector<float> previous, current, output, frame, accum, fdl;
+            int newestSlot = 0;
+            int workCursor = 0;
+            int workPerSample = 0;
+        };
+
+        // Accumulate up to 'units' (partition, bin) products into accum
+        void multiplyAdd(int s, int units)
+        {
+            const Segment& seg = kernel->segments[s];
+            State& st = states[s];
+            const int total = seg.numPartitions * seg.numBins;
+            const int end = juce::jmin(total, st.workCursor + units);
+
+            while (st.workCursor < end)
+            {
+                const int p = st.workCursor / seg.numBins;
+                const int b0 = st.workCursor - p * seg.numBins;
+                const int b1 = juce::jmin(seg.numBins, b0 + (end - st.workCursor));
+
+                int slot = st.newestSlot - p;
+                if (slot < 0) slot += seg.numPartitions;
+
+                const float* X = st.fdl.data() + slot * seg.numBins * 2;
+                const float* H = kernel->spectra.data() + seg.spectraOffset + static_cast<size_t>(p * seg.numBins * 2);
+                float* Y = st.accum.data();
+                for (int b = b0; b < b1; ++b)
+                {
+                    const float xr = X[2 * b], xi = X[2 * b + 1];
+                    const float hr = H[2 * b], hi = H[2 * b + 1];
+                    Y[2 * b]     += xr * hr - xi * hi;
+                    Y[2 * b + 1] += xr * hi + xi * hr;
+                }
+
+                st.workCursor += b1 - b0;
+            }
+        }
+
+        void blockBoundary(int s)
+        {
+            const Segment& seg = kernel->segments[s];
+            State& st = states[s];
+            const int S = seg.blockSize;
+            const int N = 2 * S;
+            const auto& fft = *kernel->ffts[s];
+
+            // Lag 2: the block started last boundary is due now; finish it first
+            if (seg.lag > 1)
+            {
+                multiplyAdd(s, seg.numPartitions * seg.numBins);
+                inverseToOutput(st, fft, S);
+                if (++st.newestSlot >= seg.numPartitions) st.newestSlot = 0;
+            }
+
+            // Overlap-save frame: previous + current block
+            std::copy(st.previous.begin(), st.previous.end(), st.frame.begin());
+            std::copy(st.current.begin(), st.current.end(), st.frame.begin() + S);
+            std::fill(st.frame.begin() + N, st.frame.end(), 0.0f);
+            fft.performRealOnlyForwardTransform(st.frame.data(), true);
+            std::copy(st.frame.begin(), st.frame.begin() + seg.numBins * 2,
+                      st.fdl.begin() + st.newestSlot * seg.numBins * 2);
+            std::swap(st.previous, st.current);
+
+            std::fill(st.accum.begin(), st.accum.end(), 0.0f);
+            st.workCursor = 0;
+
+            // Lag 1: due immediately
+            if (seg.lag == 1)
+            {
+                multiplyAdd(s, seg.numPartitions * seg.numBins);
+                inverseToOutput(st, fft, S);
+                if (++st.newestSlot >= seg.numPartitions) st.newestSlot = 0;
+            }
+        }
+
+        static void inverseToOutput(State& st, const juce::dsp::FFT& fft, int S)
+        {
+            const int N = 2 * S;
+            float* Y = st.accum.data();
+            for (int b = 1; b < S; ++b)
+            {
+                Y[2 * (N - b)]     =  Y[2 * b];
+                Y[2 * (N - b) + 1] = -Y[2 * b + 1];
+            }
+            fft.performRealOnlyInverseTransform(Y);
+            std::copy(Y + S, Y + N, st.output.begin());
+        }
+
+        std::shared_ptr<const Kernel> kernel;
+        State states[NUM_SEGMENTS];
+        uint32_t sampleCount = 0;
+    };
+};
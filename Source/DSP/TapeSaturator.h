@@ -0,0 +1,57 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "StateProbe.h"
+
+//==============================================================================
+// TapeSaturator: tanh soft clip for feedback loops, first-order ADAA
+// y[n] = (F(x[n]) - F(x[n-1])) / (x[n] - x[n-1]) with F = log(cosh(x)),
+// which suppresses aliasing without oversampling inside the loop.
+// F and the quotient are evaluated in double: in float, F cancels to ~6e-8
+// absolute error near zero, which the division by a small step turns into
+// distortion on quiet, recirculating tails.
+//==============================================================================
+class TapeSaturator
+{
+public:
+    float process(float input)
+    {
+        const double antiderivative = logCosh(input);
+        const float diff = input - lastInput;
+
+        // Ill-conditioned difference quotient: fall back to the midpoint
+        float output = std::abs(diff) > ILL_CONDITIONED
+                     ? static_cast<float>((antiderivative - lastAntiderivative) / static_cast<double>(diff))
+                     : std::tanh(0.5f * (input + lastInput));
+
+        lastInput = input;
+        lastAntiderivative = antiderivative;
+        return output;
+    }
+
+    void reset()
+    {
+        lastInput = 0.0f;
+        lastAntiderivative = 0.0;
+    }
+
+    void probeState(StateProbe& probe) const
+    {
+        probe.visit("lastInput", lastInput);
+        probe.visit("lastAntiderivative", lastAntiderivative);
+    }
+
+private:
+    static constexpr float ILL_CONDITIONED = 1.0e-3f;
+    static constexpr double LN2 = 0.6931471805599453;
+
+    // log(cosh(x)) without overflow for large |x|
+    static double logCosh(float x)
+    {
+        const double a = std::abs(static_cast<double>(x));
+        return a + std::log1p(std::exp(-2.0 * a)) - LN2;
+    }
+
+    float lastInput = 0.0f;
+    double lastAntiderivative = 0.0;
+};
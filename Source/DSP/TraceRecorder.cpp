@@ -0,0 +1,140 @@
+#include "TraceRecorder.h"
+
+namespace AbyssTrace
+{
+
+namespace
+{
+    // One process per trace file; thread ids are ring indices
+    constexpr int PROCESS_ID = 1;
+
+    // Allocated by the first session and kept: a thread that read the pointer
+    // just before a session stopped may still push into it
+    Buffers& getBuffers()
+    {
+        static const std::unique_ptr<Buffers> buffers = std::make_unique<Buffers>();
+        return *buffers;
+    }
+
+    juce::String escape(const char* text)
+    {
+        return juce::String(text != nullptr ? text : "").replace("\\", "\\\\").replace("\"", "\\\"");
+    }
+}
+
+//==============================================================================
+bool TraceSession::start(const juce::File& destination)
+{
+    // Sessions start and stop on the message thread, so nothing can claim a ring
+    // between this check and the exchange below
+    if (isRecording() || activeBuffers.load() != nullptr)
+        return false;
+
+    // Discard whatever a previous session left behind and release every ring
+    auto& buffers = getBuffers();
+    for (auto& ring : buffers.rings)
+    {
+        ring.tail.store(ring.head.load(std::memory_order_acquire), std::memory_order_release);
+        ring.dropped.store(0, std::memory_order_relaxed);
+        ring.label.store(nullptr, std::memory_order_relaxed);
+        ring.owner.store(nullptr, std::memory_order_release);
+    }
+    buffers.untracedThreadEvents.store(0, std::memory_order_relaxed);
+
+    Buffers* expected = nullptr;
+    if (! activeBuffers.compare_exchange_strong(expected, &buffers))
+        return false;
+
+    destination.deleteFile();
+    auto output = std::make_unique<juce::FileOutputStream>(destination);
+    if (! output->openedOk())
+    {
+        activeBuffers.store(nullptr);
+        return false;
+    }
+
+    stream = std::move(output);
+    file = destination;
+    firstEvent = true;
+    stream->writeText("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", false, false, nullptr);
+
+    startThread(juce::Thread::Priority::low);
+    return true;
+}
+
+void TraceSession::stop()
+{
+    if (! isRecording())
+        return;
+
+    activeBuffers.store(nullptr, std::memory_order_release);
+    stopThread(1000);
+    drain();
+
+    // Thread names, and what could not be recorded
+    const auto& buffers = getBuffers();
+    const juce::String pid(PROCESS_ID);
+    uint32_t dropped = buffers.untracedThreadEvents.load();
+    for (int i = 0; i < Buffers::MAX_THREADS; ++i)
+    {
+        const auto& ring = buffers.rings[i];
+        if (ring.owner.load() == nullptr)
+            break;
+        dropped += ring.dropped.load();
+        writeEvent("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + juce::String(i + 1)
+                   + ",\"args\":{\"name\":\"" + escape(ring.label.load()) + "\"}}");
+    }
+    writeEvent("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + pid
+               + ",\"args\":{\"name\":\"AbyssVerbVN\"}}");
+    if (dropped > 0)
+        writeEvent("{\"name\":\"dropped events: " + juce::String(static_cast<juce::int64>(dropped))
+                   + "\",\"ph\":\"i\",\"s\":\"g\",\"ts\":0,\"pid\":" + pid + ",\"tid\":0}");
+
+    stream->writeText("\n]}\n", false, false, nullptr);
+    stream->flush();
+    stream.reset();
+}
+
+void TraceSession::run()
+{
+    while (! threadShouldExit())
+    {
+        drain();
+        wait(20);
+    }
+}
+
+void TraceSession::drain()
+{
+    auto& buffers = getBuffers();
+    const juce::String pid(PROCESS_ID);
+
+    for (int i = 0; i < Buffers::MAX_THREADS; ++i)
+    {
+        auto& ring = buffers.rings[i];
+        if (ring.owner.load(std::memory_order_acquire) == nullptr)
+            break;
+
+        const uint64_t head = ring.head.load(std::memory_order_acquire);
+        for (uint64_t index = ring.tail.load(std::memory_order_relaxed); index < head; ++index)
+        {
+            const auto& e = ring.events[index % Ring::SIZE];
+            // Chrome trace timestamps are microseconds
+            writeEvent("{\"name\":\"" + escape(e.name) + "\",\"cat\":\"" + escape(e.category)
+                       + "\",\"ph\":\"X\",\"ts\":" + juce::String(static_cast<double>(e.startNs) * 1.0e-3, 3)
+                       + ",\"dur\":" + juce::String(static_cast<double>(e.durationNs) * 1.0e-3, 3)
+                       + ",\"pid\":" + pid + ",\"tid\":" + juce::String(i + 1) + "}");
+        }
+        ring.tail.store(head, std::memory_order_release);
+    }
+}
+
+void TraceSession::writeEvent(const juce::String& json)
+{
+    if (! firstEvent)
+        stream->writeText(",\n", false, false, nullptr);
+    firstEvent = false;
+    stream->writeText(json, false, false, nullptr);
+}
+
+} // namespace AbyssTrace
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+//==============================================================================
+// TraceRecorder: timeline trace of audio-thread, message-thread and worker
+// activity, written as Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+//
+// Trace points (ABYSS_TRACE_SCOPE) are compiled in unless ABYSS_TRACE is 0
+// and cost one atomic load while no TraceSession is recording. While one is,
+// each scope becomes a complete ("X") event pushed into a preallocated
+// single-producer ring owned by the calling thread: no locks, no allocation,
+// events dropped (and counted) if the ring is full. The session's writer
+// thread drains the rings to the file. Threads are labelled with the
+// category of their first event ("audio", "message", worker names).
+//==============================================================================
+
+#ifndef ABYSS_TRACE
+ #define ABYSS_TRACE 1
+#endif
+
+namespace AbyssTrace
+{
+
+struct Event
+{
+    const char* name;               // String literals only: stored by pointer
+    const char* category;
+    uint64_t startNs, durationNs;
+};
+
+// One per thread that has traced anything in the current session; claimed on
+// first use. TraceSession::start releases them all, so threads that ended in an
+// earlier session (restarted workers, a previous audio thread) don't hold one
+struct Ring
+{
+    static constexpr uint64_t SIZE = 4096;
+
+    std::atomic<juce::Thread::ThreadID> owner { nullptr };
+    std::atomic<const char*> label { nullptr };
+    std::atomic<uint64_t> head { 0 }, tail { 0 };
+    std::atomic<uint32_t> dropped { 0 };
+    Event events[SIZE];
+
+    // Owning thread only
+    void push(const Event& e) noexcept
+    {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= SIZE)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events[h % SIZE] = e;
+        head.store(h + 1, std::memory_order_release);
+    }
+};
+
+struct Buffers
+{
+    static constexpr int MAX_THREADS = 16;
+
+    Ring rings[MAX_THREADS];
+    std::atomic<uint32_t> untracedThreadEvents { 0 };     // Events from threads beyond MAX_THREADS per session
+
+    Ring* getRingForThisThread(const char* category) noexcept
+    {
+        const auto self = juce::Thread::getCurrentThreadId();
+        for (auto& ring : rings)
+        {
+            auto owner = ring.owner.load(std::memory_order_acquire);
+            if (owner == nullptr && ring.owner.compare_exchange_strong(owner, self, std::memory_order_acq_rel))
+            {
+                ring.label.store(category, std::memory_order_release);
+                return &ring;
+            }
+            if (owner == self)
+                return &ring;
+        }
+        return nullptr;
+    }
+};
+
+// Set while a TraceSession is recording
+inline std::atomic<Buffers*> activeBuffers { nullptr };
+
+inline const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+inline uint64_t now() noexcept
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count());
+}
+
+inline bool isRecording() noexcept { return activeBuffers.load(std::memory_order_relaxed) != nullptr; }
+
+inline void record(const char* name, const char* category, uint64_t startNs, uint64_t durationNs) noexcept
+{
+    auto* buffers = activeBuffers.load(std::memory_order_acquire);
+    if (buffers == nullptr)
+        return;
+
+    if (auto* ring = buffers->getRingForThisThread(category))
+        ring->push({ name, category, startNs, durationNs });
+    else
+        buffers->untracedThreadEvents.fetch_add(1, std::memory_order_relaxed);
+}
+
+class ScopedTrace
+{
+public:
+    ScopedTrace(const char* eventName, const char* eventCategory) noexcept
+        : name(eventName), category(eventCategory), armed(isRecording()), start(armed ? now() : 0)
+    {
+    }
+
+    ~ScopedTrace()
+    {
+        if (armed)
+            record(name, category, start, now() - start);
+    }
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+private:
+    const char* name;
+    const char* category;
+    const bool armed;
+    const uint64_t start;
+};
+
+//==============================================================================
+// Writes the trace file; at most one session records at a time (per binary)
+class TraceSession : private juce::Thread
+{
+public:
+    TraceSession() : juce::Thread("AbyssVerb Trace Writer") {}
+    ~TraceSession() override { stop(); }
+
+    // Message thread. False if another session is recording or the file can't be written
+    bool start(const juce::File& destination);
+    void stop();
+
+    bool isRecording() const { return stream != nullptr; }
+    juce::File getFile() const { return file; }
+
+private:
+    void run() override;
+    void drain();
+    void writeEvent(const juce::String& json);
+
+    std::unique_ptr<juce::FileOutputStream> stream;
+    juce::File file;
+    bool firstEvent = true;
+
+    JUCE_DECLARE_NON_COPYABLE(TraceSession)
+};
+
+} // namespace AbyssTrace
+
+#if ABYSS_TRACE
+ // Traces the enclosing scope as one event; name and category must be string literals
+ #define ABYSS_TRACE_SCOPE(name, category) const AbyssTrace::ScopedTrace abyssTraceScope { name, category }
+#else
+ #define ABYSS_TRACE_SCOPE(name, category)
+#endif
@@ -0,0 +1,322 @@
+#pragma once
+
+#include "DegradeOversampler.h"
+#include "TapeSaturator.h"
+#include "StateProbe.h"
+
+#include <random>
+#include <vector>
+
+//==============================================================================
+// VanishingDelay: Multi-tap delay with random vanish, degrade, and drift
+// Creates ethereal, disappearing echo tails
+// The last 250 ms of the 2 s ring hold the clean input for the reverb
+// pre-delay; echo taps never reach that far (1.5 s * 1.07 + drift).
+//==============================================================================
+class VanishingDelay
+{
+public:
+    static constexpr int NUM_TAPS = 3;
+    static constexpr double MAX_PRE_DELAY_SECONDS = 0.25;
+
+    void prepare(double sampleRate, int samplesPerBlock)
+    {
+        sr = sampleRate;
+        int maxDelaySamples = static_cast<int>(sr * 2.0); // Max 2 seconds
+        buffer.resize(static_cast<size_t>(maxDelaySamples), 0.0f);
+        writePos = 0;
+
+        // Split the ring: echo region + clean-input region for the pre-delay
+        preDelaySize = static_cast<int>(sr * MAX_PRE_DELAY_SECONDS);
+        echoSize = maxDelaySamples - preDelaySize;
+        preDelayWritePos = 0;
+
+        rng.seed(42);
+        for (int i = 0; i < NUM_TAPS; ++i)
+        {
+            tapGainTarget[i] = 1.0f;
+            tapGainCurrent[i] = 1.0f;
+            tapTimer[i] = 0;
+            tapDrift[i] = 0.0f;
+            tapDriftPhase[i] = static_cast<float>(i) * 0.33f;
+        }
+        resetDegradePaths();
+    }
+
+    void setParameters(float delayTimeMs, float feedback, float vanishRate,
+                       float degradeAmount, float driftAmount)
+    {
+        this->delayTimeMs = delayTimeMs;
+        this->feedback = feedback;
+        this->vanishRate = vanishRate;
+        this->degradeAmount = degradeAmount;
+        this->driftAmount = driftAmount;
+    }
+
+    // Soft-clip the feedback path (input stays clean)
+    void setSaturation(bool shouldSaturate)
+    {
+        if (shouldSaturate && ! saturate)
+            saturator.reset();
+        saturate = shouldSaturate;
+    }
+
+    // 1, 2 or 4: oversampling of the degrade LPF + quantizer on each tap,
+    // bypassed (factor 1) while the quantizer is off
+    void setDegradeOversampling(int factor)
+    {
+        degradeOversampling = factor;
+    }
+
+    float process(float input)
+    {
+        size_t bufSize = static_cast<size_t>(echoSize);
+
+        // Clean input for the reverb pre-delay
+        buffer[static_cast<size_t>(echoSize + preDelayWritePos)] = input;
+        if (++preDelayWritePos == preDelaySize)
+            preDelayWritePos = 0;
+
+        // Golden ratio-based tap spacing (natural feel)
+        const float tapRatios[NUM_TAPS] = { 1.0f, 0.618f, 0.382f };
+
+        float output = 0.0f;
+
+        // Degrade LPF + quantizer; below the threshold the quantizer is off and
+        // nothing needs oversampling
+        const bool crushing = degradeAmount > DEGRADE_THRESHOLD;
+        const int factor = crushing ? degradeOversampling : 1;
+        if (factor != degradePaths[currentPath].oversampler[0].getFactor())
+            switchDegradePath(factor);
+        idle = false;
+
+        const float lpCoeff = 1.0f - degradeAmount * 0.9f;
+        const float levels = std::pow(2.0f, 16.0f - degradeAmount * 12.0f);    // 16bit -> 4bit
+
+        // Oversampling factor change: the outgoing path is heard until the incoming one has filled
+        const bool transition = pathWarmup > 0 || pathFade > 0;
+        const float fadeGain = pathWarmup > 0 ? 0.0f
+                             : 1.0f - static_cast<float>(pathFade) / static_cast<float>(PATH_FADE_SAMPLES);
+
+        for (int i = 0; i < NUM_TAPS; ++i)
+        {
+            // Random vanish: taps randomly drop to zero
+            tapTimer[i]--;
+            if (tapTimer[i] <= 0)
+            {
+                std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+                float roll = dist(rng);
+
+                if (roll < vanishRate)
+                    tapGainTarget[i] = 0.0f;  // Vanish!
+                else
+                    tapGainTarget[i] = dist(rng) * 0.7f + 0.3f; // Return with reduced level
+
+                // Time until next change
+                std::uniform_int_distribution<int> timeDist(
+                    static_cast<int>(sr * 0.05),
+                    static_cast<int>(sr * 0.4)
+                );
+                tapTimer[i] = timeDist(rng);
+            }
+
+            // Smooth gain transition
+            tapGainCurrent[i] += (tapGainTarget[i] - tapGainCurrent[i]) * 0.001f;
+
+            // Delay time drift (floating effect)
+            tapDriftPhase[i] += driftAmount * 0.1f / static_cast<float>(sr);
+            if (tapDriftPhase[i] >= 1.0f) tapDriftPhase[i] -= 1.0f;
+            float drift = std::sin(2.0f * juce::MathConstants<float>::pi * tapDriftPhase[i])
+                        * driftAmount * (static_cast<float>(sr) / 1000.0f);
+
+            // Read position before the degrade path's latency is taken off
+            const float delaySamples = delayTimeMs * tapRatios[i] * (static_cast<float>(sr) / 1000.0f) + drift;
+
+            float tapOut = degrade(degradePaths[currentPath], i, delaySamples, lpCoeff, crushing, levels);
+            if (transition)
+            {
+                const float outgoing = degrade(degradePaths[currentPath ^ 1], i, delaySamples, lpCoeff, crushing, levels);
+                tapOut = outgoing + (tapOut - outgoing) * fadeGain;
+            }
+
+            output += tapOut * tapGainCurrent[i];
+        }
+
+        if (pathWarmup > 0)
+            --pathWarmup;
+        else if (pathFade > 0)
+            --pathFade;
+
+        output /= static_cast<float>(NUM_TAPS);
+
+        // Write to buffer with feedback
+        float recirculated = output * feedback;
+        if (saturate)
+            recirculated = saturator.process(recirculated);
+        buffer[writePos] = input + recirculated;
+        writePos = (writePos + 1) % static_cast<int>(bufSize);
+
+        return output;
+    }
+
+    // Input as it was delaySamples ago, interpolated; 0 is the sample the last
+    // process() call wrote (preDelayWritePos already points past it)
+    float readInput(float delaySamples) const
+    {
+        delaySamples = juce::jlimit(0.0f, static_cast<float>(preDelaySize - 1), delaySamples);
+
+        float readPosF = static_cast<float>(preDelayWritePos - 1) - delaySamples;
+        if (readPosF < 0.0f) readPosF += static_cast<float>(preDelaySize);
+        int readIdx0 = static_cast<int>(readPosF);
+        int readIdx1 = readIdx0 + 1 == preDelaySize ? 0 : readIdx0 + 1;
+        float frac = readPosF - static_cast<float>(readIdx0);
+
+        const float* region = buffer.data() + echoSize;
+        return region[readIdx0] * (1.0f - frac) + region[readIdx1] * frac;
+    }
+
+    void clear()
+    {
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+        for (int i = 0; i < NUM_TAPS; ++i)
+        {
+            tapGainCurrent[i] = 1.0f;
+            tapGainTarget[i] = 1.0f;
+        }
+        saturator.reset();
+        resetDegradePaths();
+    }
+
+    void probeState(StateProbe& probe) const
+    {
+        probe.visit("buffer", buffer);
+        saturator.probeState(probe);
+        for (const auto& path : degradePaths)
+        {
+            probe.visit("degradeLPState", path.lpState);
+            for (const auto& os : path.oversampler)
+                os.probeState(probe);
+        }
+    }
+
+private:
+    static constexpr float DEGRADE_THRESHOLD = 0.01f;
+    static constexpr int PATH_FADE_SAMPLES = 64;
+
+    // Degrade stage for every tap at one oversampling factor
+    struct DegradePath
+    {
+        DegradeOversampler oversampler[NUM_TAPS];
+        float lpState[NUM_TAPS] = {};
+    };
+
+    // A change of factor (setting, or the quantizer switching on / off) warms
+    // the new path up behind the old one, then crossfades; the oversampled
+    // path's filters never start empty and its earlier read never jumps
+    void switchDegradePath(int factor)
+    {
+        if (idle)
+        {
+            // Nothing audible to fade from
+            for (auto& os : degradePaths[currentPath].oversampler)
+                os.setFactor(factor);
+            return;
+        }
+
+        // Mid-transition: retarget the incoming path, the outgoing one stays audible
+        if (pathWarmup == 0 && pathFade == 0)
+            currentPath ^= 1;
+        DegradePath& incoming = degradePaths[currentPath];
+        const DegradePath& outgoing = degradePaths[currentPath ^ 1];
+        for (int i = 0; i < NUM_TAPS; ++i)
+        {
+            incoming.oversampler[i].setFactor(factor);
+            incoming.lpState[i] = outgoing.lpState[i];     // Same cutoff and DC gain at either rate
+        }
+        pathWarmup = 2 * static_cast<int>(std::ceil(incoming.oversampler[0].getLatency())) + 1;
+        pathFade = PATH_FADE_SAMPLES;
+    }
+
+    // Reads the tap early by the path's filter latency and runs LPF + quantizer
+    float degrade(DegradePath& path, int tap, float delaySamples, float lpCoeff, bool crushing, float levels)
+    {
+        DegradeOversampler& os = path.oversampler[tap];
+        const size_t bufSize = static_cast<size_t>(echoSize);
+
+        delaySamples = juce::jlimit(1.0f, static_cast<float>(bufSize - 1), delaySamples - os.getLatency());
+
+        float readPosF = static_cast<float>(writePos) - delaySamples;
+        if (readPosF < 0.0f) readPosF += static_cast<float>(bufSize);
+        size_t readIdx0 = static_cast<size_t>(readPosF) % bufSize;
+        size_t readIdx1 = (readIdx0 + 1) % bufSize;
+        float frac = readPosF - std::floor(readPosF);
+
+        float tapOut = buffer[readIdx0] * (1.0f - frac) + buffer[readIdx1] * frac;
+        float& lpState = path.lpState[tap];
+
+        // Degradation effects: LPF + bit reduction for ethereal decay
+        if (os.getFactor() > 1)
+        {
+            // Same LPF cutoff at the higher rate: c^(1/factor)
+            float osCoeff = std::sqrt(lpCoeff);
+            if (os.getFactor() == 4)
+                osCoeff = std::sqrt(osCoeff);
+
+            return os.process(tapOut, [&](float x)
+            {
+                lpState = x * (1.0f - osCoeff) + lpState * osCoeff;
+                return crushing ? std::round(lpState * levels) / levels : lpState;   // Outgoing after a bypass
+            });
+        }
+
+        lpState = tapOut * (1.0f - lpCoeff) + lpState * lpCoeff;
+        tapOut = lpState;
+
+        // Bit depth reduction (adds ethereal grit)
+        if (crushing)
+            tapOut = std::round(tapOut * levels) / levels;
+        return tapOut;
+    }
+
+    void resetDegradePaths()
+    {
+        for (auto& path : degradePaths)
+        {
+            for (auto& os : path.oversampler)
+                os.reset();
+            std::fill(std::begin(path.lpState), std::end(path.lpState), 0.0f);
+        }
+        pathWarmup = pathFade = 0;
+        idle = true;
+    }
+
+    double sr = 44100.0;
+    std::vector<float> buffer;
+    int writePos = 0;
+    int echoSize = 1;
+    int preDelaySize = 1;
+    int preDelayWritePos = 0;
+
+    float delayTimeMs = 400.0f;
+    float feedback = 0.5f;
+    float vanishRate = 0.3f;
+    float degradeAmount = 0.3f;
+    float driftAmount = 2.0f;
+
+    float tapGainTarget[NUM_TAPS] = {};
+    float tapGainCurrent[NUM_TAPS] = {};
+    int tapTimer[NUM_TAPS] = {};
+    float tapDrift[NUM_TAPS] = {};
+    float tapDriftPhase[NUM_TAPS] = {};
+
+    TapeSaturator saturator;
+    bool saturate = false;
+
+    DegradePath degradePaths[2];
+    int degradeOversampling = 1;           // Requested factor
+    int currentPath = 0;
+    int pathWarmup = 0, pathFade = 0;      // Samples left of a factor change
+    bool idle = true;                      // Nothing processed since prepare / clear
+
+    std::mt19937 rng;
+};
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "PickupIRConvolver.h"
+#include "StateProbe.h"
+
+//==============================================================================
+// ViolinInputConditioner: Piezo pickup correction for violin
+// Compensates for piezo characteristics: high-pass filtering,
+// body resonance enhancement, and transient smoothng
+//==============================================================================
+class ViolinInputConditioner
+{
+public:
+    void prepare(double sampleRate)
+    {
+        sr = sampleRate;
+        reset();
+
+        // Piezo correction: high-pass to remove sub-bass rumble
+        hpCoeff = std::exp(-2.0f * juce::MathConstants<float>::pi * 80.0f / static_cast<float>(sr));
+
+        // Body resonance: peaking EQ at violin body resonance (~300Hz)
+        float bodyFreq = 300.0f;
+        float bodyQ = 2.0f;
+        float bodyGain = 6.0f; // dB boost for body resonance
+        float omega = 2.0f * juce::MathConstants<float>::pi * bodyFreq / static_cast<float>(sr);
+        float alpha = std::sin(omega) / (2.0f * bodyQ);
+        float A = std::pow(10.0f, bodyGain / 40.0f);
+
+        bodyB0 = 1.0f + alpha * A;
+        bodyB1 = -2.0f * std::cos(omega);
+        bodyB2 = 1.0f - alpha * A;
+        bodyA0 = 1.0f + alpha / A;
+        bodyA1 = -2.0f * std::cos(omega);
+        bodyA2 = 1.0f - alpha / A;
+
+        // Normalize
+        bodyB0 /= bodyA0;
+        bodyB1 /= bodyA0;
+        bodyB2 /= bodyA0;
+        bodyA1 /= bodyA0;
+        bodyA2 /= bodyA0;
+
+        // Brightness shelf: design for the current setting, no ramp
+        designShelf(brightness, shelfCoeffs);
+        designedBrightness = brightness;
+        std::fill(std::begin(shelfDelta), std::end(shelfDelta), 0.0f);
+        shelfRamp = 0;
+        controlCountdown = 0;
+    }
+
+    void setParameters(float piezoCorrect, float bodyResonance, float brightness)
+    {
+        this->piezoCorrect = piezoCorrect;
+        this->bodyResonance = bodyResonance;
+        this->brightness = brightness;
+    }
+
+    // Message thread: install a measured pickup/body IR engine (nullptr reverts to fixed filters)
+    void setImpulseResponse(std::unique_ptr<PickupIRConvolver::Engine> engine)
+    {
+        irConvolver.load(std::move(engine));
+    }
+
+    // Audio thread: pick up a newly prepared IR engine (call once per block)
+    void updateImpulseResponse()
+    {
+        irConvolver.update();
+    }
+
+    // Audio thread: true while a measured IR replaces the fixed filters
+    bool hasImpulseResponse() const { return irConvolver.isActive(); }
+
+    float process(float input)
+    {
+        float withBody;
+
+        if (irConvolver.isActive())
+        {
+            // Measured IR replaces the fixed high-pass + body peak; piezoCorrect sets the amount
+            float irOut = irConvolver.process(input);
+            withBody = input + (irOut - input) * piezoCorrect;
+        }
+        else
+        {
+            // High-pass filter for piezo correction
+            hpState = input * (1.0f - hpCoeff) + hpState * hpCoeff;
+            float corrected = input - hpState * piezoCorrect;
+
+            // Body resonance filter
+            float bodyOut = bodyB0 * corrected + bodyB1 * bodyX1 + bodyB2 * bodyX2
+                          - bodyA1 * bodyY1 - bodyA2 * bodyY2;
+            bodyX2 = bodyX1;
+            bodyX1 = corrected;
+            bodyY2 = bodyY1;
+            bodyY1 = bodyOut;
+            bodyOut = juce::jlimit(-10.0f, 10.0f, bodyOut);
+
+            // Mix in body resonance based on parameter
+            withBody = corrected * (1.0f - bodyResonance * 0.5f) + bodyOut * (bodyResonance * 0.5f);
+        }
+
+        // Brightness: high-shelf redesigned at control rate, coefficients ramped in between
+        if (--controlCountdown <= 0)
+        {
+            controlCountdown = CONTROL_INTERVAL;
+            updateShelf();
+        }
+
+        if (shelfRamp > 0)
+        {
+            if (--shelfRamp == 0)
+                std::copy(std::begin(shelfTarget), std::end(shelfTarget), shelfCoeffs);
+            else
+                for (int i = 0; i < 5; ++i)
+                    shelfCoeffs[i] += shelfDelta[i];
+        }
+
+        // Transposed direct form II
+        float brightOut = shelfCoeffs[0] * withBody + shelfZ1;
+        shelfZ1 = shelfCoeffs[1] * withBody - shelfCoeffs[3] * brightOut + shelfZ2;
+        shelfZ2 = shelfCoeffs[2] * withBody - shelfCoeffs[4] * brightOut;
+
+        return juce::jlimit(-1.0f, 1.0f, brightOut);
+    }
+
+    void reset()
+    {
+        hpState = 0.0f;
+        bodyX1 = bodyX2 = bodyY1 = bodyY2 = 0.0f;
+        shelfZ1 = shelfZ2 = 0.0f;
+    }
+
+    void probeState(StateProbe& probe) const
+    {
+        probe.visit("hpState", hpState);
+        probe.visit("bodyX1", bodyX1);
+        probe.visit("bodyX2", bodyX2);
+        probe.visit("bodyY1", bodyY1);
+        probe.visit("bodyY2", bodyY2);
+        probe.visit("shelfZ1", shelfZ1);
+        probe.visit("shelfZ2", shelfZ2);
+        irConvolver.probeState(probe);
+    }
+
+private:
+    static constexpr int CONTROL_INTERVAL = 32;      // Samples between shelf redesigns
+    static constexpr float SHELF_FREQ = 3000.0f;     // Violin "air" / bow noise region
+    static constexpr float SHELF_RANGE_DB = 9.0f;    // brightness 0..1 -> -9..+9 dB
+
+    // Redesign only when the knob has actually moved; ramp over one control interval
+    void updateShelf()
+    {
+        if (std::abs(brightness - designedBrightness) < 1.0e-4f)
+            return;
+
+        designedBrightness = brightness;
+        designShelf(brightness, shelfTarget);
+
+        for (int i = 0; i < 5; ++i)
+            shelfDelta[i] = (shelfTarget[i] - shelfCoeffs[i]) / static_cast<float>(CONTROL_INTERVAL);
+        shelfRamp = CONTROL_INTERVAL;
+    }
+
+    // RBJ high-shelf (S = 1), normalized: { b0, b1, b2, a1, a2 }
+    void designShelf(float brightnessValue, float* coeffs) const
+    {
+        float gainDb = (brightnessValue * 2.0f - 1.0f) * SHELF_RANGE_DB;
+        float A = std::pow(10.0f, gainDb / 40.0f);
+        float omega = 2.0f * juce::MathConstants<float>::pi * SHELF_FREQ / static_cast<float>(sr);
+        float cosW = std::cos(omega);
+        float alpha = std::sin(omega) / 2.0f * juce::MathConstants<float>::sqrt2;
+        float twoSqrtAAlpha = 2.0f * std::sqrt(A) * alpha;
+
+        float b0 = A * ((A + 1.0f) + (A - 1.0f) * cosW + twoSqrtAAlpha);
+        float b1 = -2.0f * A * ((A - 1.0f) + (A + 1.0f) * cosW);
+        float b2 = A * ((A + 1.0f) + (A - 1.0f) * cosW - twoSqrtAAlpha);
+        float a0 = (A + 1.0f) - (A - 1.0f) * cosW + twoSqrtAAlpha;
+        float a1 = 2.0f * ((A - 1.0f) - (A + 1.0f) * cosW);
+        float a2 = (A + 1.0f) - (A - 1.0f) * cosW - twoSqrtAAlpha;
+
+        coeffs[0] = b0 / a0;
+        coeffs[1] = b1 / a0;
+        coeffs[2] = b2 / a0;
+        coeffs[3] = a1 / a0;
+        coeffs[4] = a2 / a0;
+    }
+
+    double sr = 44100.0;
+    float hpCoeff = 0.99f;
+    float hpState = 0.0f;
+
+    float bodyB0 = 1.0f, bodyB1 = 0.0f, bodyB2 = 0.0f;
+    float bodyA0 = 1.0f, bodyA1 = 0.0f, bodyA2 = 0.0f;
+    float bodyX1 = 0.0f, bodyX2 = 0.0f, bodyY1 = 0.0f, bodyY2 = 0.0f;
+
+    float piezoCorrect = 1.0f;
+    float bodyResonance = 0.5f;
+    float brightness = 0.5f;
+
+    // Brightness high-shelf state
+    float shelfCoeffs[5] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    float shelfTarget[5] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    float shelfDelta[5] = {};
+    float shelfZ1 = 0.0f, shelfZ2 = 0.0f;
+    float designedBrightness = -1.0f;
+    int shelfRamp = 0;
+    int controlCountdown = 0;
+
+    PickupIRConvolver irConvolver;
+};
@@ -3,7 +3,7 @@
 
 //==============================================================================
 AbyssVerbVNAudioProcessorEditor::AbyssVerbVNAudioProcessorEditor(AbyssVerbVNAudioProcessor& p)
-    : AudioProcessorEditor(&p), audioProcessor(p)
+    : AudioProcessorEditor(&p), audioProcessor(p), cpuOverlay(p), deadlineMeter(p)
 {
     setSize(900, 620);
 
@@ -12,6 +12,8 @@ AbyssVerbVNAudioProcessorEditor::AbyssVerbVNAudioProcessorEditor(AbyssVerbVNAudi
     setupKnob(bodyResonanceKnob,    "bodyResonance",    "BODY RESONANCE");
     setupKnob(brightnessKnob,       "brightness",       "BRIGHTNESS");
     setupKnob(bowSensitivityKnob,  "bowSensitivity",  "BOW SENSITIVITY");
+    setupKnob(sympatheticKnob,     "sympathetic",     "SYMPATHETIC");
+    setupKnob(pitchFollowKnob,     "pitchFollow",     "PITCH FOLLOW");
 
     // === Abyss Reverb Section ===
     setupKnob(reverbDecayKnob,     "reverbDecay",     "ABYSS DEPTH");
@@ -20,6 +22,9 @@ AbyssVerbVNAudioProcessorEditor::AbyssVerbVNAudioProcessorEditor(AbyssVerbVNAudi
     setupKnob(reverbModDepthKnob,  "reverbModDepth",  "MOD DEPTH");
     setupKnob(reverbModRateKnob,   "reverbModRate",   "MOD RATE");
     setupKnob(detuneKnob,          "detuneAmount",    "DETUNE");
+    setupKnob(diffusionKnob,       "diffusion",       "DIFFUSION");
+    setupKnob(preDelayKnob,        "preDelay",        "PRE-DELAY");
+    setupKnob(shimmerKnob,         "shimmer",         "SHIMMER");
 
     // === Vanishing Delay Section ===
     setupKnob(delayTimeKnob,       "delayTime",       "DELAY TIME");
@@ -32,6 +37,64 @@ AbyssVerbVNAudioProcessorEditor::AbyssVerbVNAudioProcessorEditor(AbyssVerbVNAudi
     setupKnob(reverbMixKnob,       "reverbMix",       "REVERB MIX");
     setupKnob(delayMixKnob,        "delayMix",        "DELAY MIX");
     setupKnob(masterMixKnob,       "masterMix",       "MASTER MIX");
+
+    setupIRControls();
+    setupCpuOverlay();
+    setupTraceButton();
+
+    howlGuardButton.setColour(juce::ToggleButton::textColourId, juce::Colour(0xFF6699AA));
+    howlGuardButton.setColour(juce::ToggleButton::tickColourId, juce::Colour(0xFF4A9EBF));
+    addAndMakeVisible(howlGuardButton);
+    howlGuardAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.apvts, "feedbackSuppress", howlGuardButton);
+
+    convTailButton.setColour(juce::ToggleButton::textColourId, juce::Colour(0xFF6699AA));
+    convTailButton.setColour(juce::ToggleButton::tickColourId, juce::Colour(0xFF4A9EBF));
+    addAndMakeVisible(convTailButton);
+    convTailAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.apvts, "convTail", convTailButton);
+
+    freezeButton.setColour(juce::ToggleButton::textColourId, juce::Colour(0xFF6699AA));
+    freezeButton.setColour(juce::ToggleButton::tickColourId, juce::Colour(0xFF4A9EBF));
+    addAndMakeVisible(freezeButton);
+    freezeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.apvts, "freeze", freezeButton);
+
+    tapeSatButton.setColour(juce::ToggleButton::textColourId, juce::Colour(0xFF6699AA));
+    tapeSatButton.setColour(juce::ToggleButton::tickColourId, juce::Colour(0xFF4A9EBF));
+    addAndMakeVisible(tapeSatButton);
+    tapeSatAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.apvts, "tapeSaturation", tapeSatButton);
+
+    engineBox.addItemList({ "ENGINE: ABYSS FDN", "ENGINE: ECO PLATE" }, 1);
+    freezeModeBox.addItemList({ "FREEZE: LOOP", "FREEZE: SPECTRAL" }, 1);
+    spectralHopBox.addItemList({ "HOP 1024", "HOP 512", "HOP 256" }, 1);
+    for (auto* box : { &engineBox, &freezeModeBox, &spectralHopBox })
+    {
+        box->setColour(juce::ComboBox::backgroundColourId, juce::Colour(0xFF1A2A3A));
+        box->setColour(juce::ComboBox::textColourId, juce::Colour(0xFFAADDEE));
+        addAndMakeVisible(*box);
+    }
+    engineAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.apvts, "reverbEngine", engineBox);
+    freezeModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.apvts, "freezeMode", freezeModeBox);
+    spectralHopAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.apvts, "spectralHop", spectralHopBox);
+
+    shimmerIntervalBox.addItemList({ "SHIMMER OCTAVE", "SHIMMER FIFTH" }, 1);
+    shimmerIntervalBox.setColour(juce::ComboBox::backgroundColourId, juce::Colour(0xFF1A2A3A));
+    shimmerIntervalBox.setColour(juce::ComboBox::textColourId, juce::Colour(0xFFAADDEE));
+    addAndMakeVisible(shimmerIntervalBox);
+    shimmerIntervalAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.apvts, "shimmerInterval", shimmerIntervalBox);
+
+    degradeOversamplingBox.addItemList({ "DEGRADE OS OFF", "DEGRADE OS 2X", "DEGRADE OS 4X" }, 1);
+    degradeOversamplingBox.setColour(juce::ComboBox::backgroundColourId, juce::Colour(0xFF1A2A3A));
+    degradeOversamplingBox.setColour(juce::ComboBox::textColourId, juce::Colour(0xFFAADDEE));
+    addAndMakeVisible(degradeOversamplingBox);
+    degradeOversamplingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.apvts, "degradeOversampling", degradeOversamplingBox);
 }
 
 AbyssVerbVNAudioProcessorEditor::~AbyssVerbVNAudioProcessorEditor() {}
@@ -62,8 +125,108 @@ void AbyssVerbVNAudioProcessorEditor::setupKnob(KnobWithLabel& knob,
         audioProcessor.apvts, paramId, knob.slider);
 }
 
+void AbyssVerbVNAudioProcessorEditor::setupIRControls()
+{
+    for (auto* button : { &loadIRButton, &clearIRButton })
+    {
+        button->setColour(juce::TextButton::buttonColourId, juce::Colour(0xFF1A2A3A));
+        button->setColour(juce::TextButton::textColourOffId, juce::Colour(0xFFAADDEE));
+        addAndMakeVisible(*button);
+    }
+
+    loadIRButton.onClick = [this]
+    {
+        irChooser = std::make_unique<juce::FileChooser>("Load pickup/body impulse response",
+                                                        audioProcessor.getPickupIRFile(),
+                                                        "*.wav;*.aif;*.aiff;*.flac");
+        irChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                               [this](const juce::FileChooser& chooser)
+                               {
+                                   auto file = chooser.getResult();
+                                   if (file.existsAsFile())
+                                       audioProcessor.loadPickupIR(file);
+                                   updateIRLabel();
+                               });
+    };
+
+    clearIRButton.onClick = [this]
+    {
+        audioProcessor.clearPickupIR();
+        updateIRLabel();
+    };
+
+    irNameLabel.setJustificationType(juce::Justification::centredRight);
+    irNameLabel.setFont(juce::Font(10.0f));
+    irNameLabel.setColour(juce::Label::textColourId, juce::Colour(0xFF6699AA));
+    addAndMakeVisible(irNameLabel);
+
+    updateIRLabel();
+}
+
+void AbyssVerbVNAudioProcessorEditor::updateIRLabel()
+{
+    auto file = audioProcessor.getPickupIRFile();
+    irNameLabel.setText(file.existsAsFile() ? "IR: " + file.getFileNameWithoutExtension()
+                                            : juce::String("IR: FIXED FILTERS"),
+                        juce::dontSendNotification);
+}
+
+void AbyssVerbVNAudioProcessorEditor::setupCpuOverlay()
+{
+    cpuButton.setClickingTogglesState(true);
+    cpuButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xFF1A2A3A));
+    cpuButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour(0xFF2A4A5A));
+    cpuButton.setColour(juce::TextButton::textColourOffId, juce::Colour(0xFF6699AA));
+    cpuButton.setColour(juce::TextButton::textColourOnId, juce::Colour(0xFFAADDEE));
+    addAndMakeVisible(cpuButton);
+    addAndMakeVisible(deadlineMeter);
+
+    // Profiling stays on across editor instances until switched off here
+    const bool profiling = audioProcessor.getStageProfiler().isEnabled();
+    cpuButton.setToggleState(profiling, juce::dontSendNotification);
+    addChildComponent(cpuOverlay);
+    cpuOverlay.setVisible(profiling);
+
+    cpuButton.onClick = [this]
+    {
+        const bool on = cpuButton.getToggleState();
+        audioProcessor.getStageProfiler().setEnabled(on);
+        cpuOverlay.setVisible(on);
+    };
+}
+
+void AbyssVerbVNAudioProcessorEditor::setupTraceButton()
+{
+    traceButton.setClickingTogglesState(true);
+    traceButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xFF1A2A3A));
+    traceButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour(0xFF5A2A2A));
+    traceButton.setColour(juce::TextButton::textColourOffId, juce::Colour(0xFF6699AA));
+    traceButton.setColour(juce::TextButton::textColourOnId, juce::Colour(0xFFEECCAA));
+    traceButton.setToggleState(audioProcessor.isTracing(), juce::dontSendNotification);
+    addAndMakeVisible(traceButton);
+
+    traceButton.onClick = [this]
+    {
+        if (traceButton.getToggleState())
+        {
+            const auto file = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                                  .getChildFile("AbyssVerbVN-trace-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S") + ".json");
+            if (! audioProcessor.startTrace(file))
+                traceButton.setToggleState(false, juce::dontSendNotification);
+        }
+        else if (audioProcessor.isTracing())
+        {
+            const auto file = audioProcessor.getTraceFile();
+            audioProcessor.stopTrace();
+            file.revealToUser();
+        }
+    };
+}
+
 void AbyssVerbVNAudioProcessorEditor::paint(juce::Graphics& g)
 {
+    ABYSS_TRACE_SCOPE("editor paint", "message");
+
     // Dark gradient background (standard, no image loading)
     juce::ColourGradient gradient(
         juce::Colour(0xFF0A0E14), 0.0f, 0.0f,
@@ -128,30 +291,49 @@ void AbyssVerbVNAudioProcessorEditor::resized()
         knob.label.setBounds(x, y + knobHeight, knobWidth, labelHeight);
     };
 
-    // === Violin Input Conditioning (4 knobs) ===
-    // Center the 4 knobs in the top section
-    int inputStartX = (getWidth() - (4 * spacingX - 35)) / 2 + 10;
+    // === Violin Input Conditioning (6 knobs) ===
+    // Center the 6 knobs in the top section
+    int inputStartX = (getWidth() - (6 * spacingX - 35)) / 2 + 10;
     int inputY = 70;
     placeKnob(piezoCorrectKnob,   inputStartX,                  inputY);
     placeKnob(bodyResonanceKnob,   inputStartX + spacingX,       inputY);
     placeKnob(brightnessKnob,      inputStartX + spacingX * 2,   inputY);
     placeKnob(bowSensitivityKnob, inputStartX + spacingX * 3,   inputY);
+    placeKnob(sympatheticKnob,    inputStartX + spacingX * 4,   inputY);
+    placeKnob(pitchFollowKnob,    inputStartX + spacingX * 5,   inputY);
+
+    // Header row: howl guard toggle and pickup IR controls
+    howlGuardButton.setBounds(180, 53, 120, 20);
+    clearIRButton.setBounds(getWidth() - 95, 53, 70, 20);
+    loadIRButton.setBounds(getWidth() - 170, 53, 70, 20);
+    irNameLabel.setBounds(getWidth() - 380, 53, 205, 20);
 
-    // === Abyss Reverb (6 knobs) ===
-    // 2 rows of 3 knobs
-    int reverbStartX = (getWidth() - (3 * spacingX - 35)) / 2 + 10;
+    // === Abyss Reverb (9 knobs) ===
+    // 2 rows of up to 5 knobs
+    int reverbStartX = (getWidth() - (5 * spacingX - 35)) / 2 + 10;
     int reverbY1 = 178;
     int reverbY2 = 285;
+    convTailButton.setBounds(180, 163, 120, 20);
+    freezeButton.setBounds(305, 163, 100, 20);
+    shimmerIntervalBox.setBounds(410, 163, 140, 20);
+    freezeModeBox.setBounds(555, 163, 150, 20);
+    engineBox.setBounds(getWidth() - 195, 15, 175, 20);
+    spectralHopBox.setBounds(710, 163, 100, 20);
     placeKnob(reverbDecayKnob,    reverbStartX,                  reverbY1);
     placeKnob(reverbDampHighKnob, reverbStartX + spacingX,       reverbY1);
     placeKnob(reverbDampLowKnob,  reverbStartX + spacingX * 2,   reverbY1);
+    placeKnob(diffusionKnob,      reverbStartX + spacingX * 3,   reverbY1);
+    placeKnob(shimmerKnob,        reverbStartX + spacingX * 4,   reverbY1);
     placeKnob(reverbModDepthKnob, reverbStartX,                  reverbY2);
     placeKnob(reverbModRateKnob,  reverbStartX + spacingX,       reverbY2);
     placeKnob(detuneKnob,         reverbStartX + spacingX * 2,   reverbY2);
+    placeKnob(preDelayKnob,       reverbStartX + spacingX * 3,   reverbY2);
 
     // === Vanishing Delay (5 knobs) ===
     int delayStartX = (getWidth() - (5 * spacingX - 35)) / 2 + 10;
     int delayY = 328;
+    tapeSatButton.setBounds(180, 318, 120, 20);
+    degradeOversamplingBox.setBounds(305, 318, 140, 20);
     placeKnob(delayTimeKnob,     delayStartX,                  delayY);
     placeKnob(delayFeedbackKnob, delayStartX + spacingX,       delayY);
     placeKnob(vanishRateKnob,    delayStartX + spacingX * 2,   delayY);
@@ -165,4 +347,157 @@ void AbyssVerbVNAudioProcessorEditor::resized()
     placeKnob(reverbMixKnob, mixStartX,                  mixY);
     placeKnob(delayMixKnob,  mixStartX + spacingX,       mixY);
     placeKnob(masterMixKnob, mixStartX + spacingX * 2,   mixY);
+
+    // CPU overlay: right of the mix knobs
+    cpuButton.setBounds(20, 15, 50, 20);
+    deadlineMeter.setBounds(78, 10, 230, 30);
+    traceButton.setBounds(getWidth() - 255, 15, 55, 20);
+    cpuOverlay.setBounds(getWidth() - 215, 492, 200, 118);
+}
+
+//==============================================================================
+StageProfilerOverlay::StageProfilerOverlay(AbyssVerbVNAudioProcessor& p)
+    : audioProcessor(p)
+{
+    setInterceptsMouseClicks(false, false);
+}
+
+StageProfilerOverlay::~StageProfilerOverlay() { stopTimer(); }
+
+void StageProfilerOverlay::visibilityChanged()
+{
+    if (isVisible())
+    {
+        previous = audioProcessor.getStageProfiler().getSnapshot();
+        interval = {};
+        startTimerHz(4);
+    }
+    else
+    {
+        stopTimer();
+    }
+}
+
+void StageProfilerOverlay::timerCallback()
+{
+    const auto now = audioProcessor.getStageProfiler().getSnapshot();
+    interval = now - previous;
+    previous = now;
+    repaint();
+}
+
+void StageProfilerOverlay::paint(juce::Graphics& g)
+{
+    g.setColour(juce::Colour(0xE0081018));
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 4.0f);
+    g.setColour(juce::Colour(0xFF1A3344));
+    g.drawRoundedRectangle(getLocalBounds().toFloat().reduced(0.5f), 4.0f, 1.0f);
+
+    auto area = getLocalBounds().reduced(8, 6);
+    g.setFont(juce::Font(10.0f, juce::Font::bold));
+
+    // Budget: the audio time the profiled blocks covered
+    const double sampleRate = audioProcessor.getSampleRate();
+    const double budget = sampleRate > 0.0 ? static_cast<double>(interval.samples) / sampleRate : 0.0;
+    if (interval.blocks == 0 || budget <= 0.0)
+    {
+        g.setColour(juce::Colour(0xFF6699AA));
+        g.drawText("CPU: NO AUDIO", area.removeFromTop(12), juce::Justification::centredLeft);
+        return;
+    }
+
+    g.setColour(juce::Colour(0xFFAADDEE));
+    g.drawText("CPU " + juce::String(100.0 * interval.seconds / budget, 1) + "% OF BUDGET",
+               area.removeFromTop(12), juce::Justification::centredLeft);
+    area.removeFromTop(2);
+
+    g.setFont(juce::Font(9.0f));
+    for (int stage = 0; stage < StageProfiler::numStages; ++stage)
+    {
+        const double percent = 100.0 * interval.getStageSeconds(stage) / budget;
+        auto row = area.removeFromTop(11);
+
+        g.setColour(juce::Colour(0xFF6699AA));
+        g.drawText(juce::String(StageProfiler::getStageName(stage)).toUpperCase(),
+                   row.removeFromLeft(72), juce::Justification::centredLeft);
+        g.drawText(juce::String(percent, 2) + "%", row.removeFromRight(42), juce::Justification::centredRight);
+
+        // Bar: full width at 25% of the budget for a single stage
+        auto bar = row.reduced(2, 2).toFloat();
+        g.setColour(juce::Colour(0xFF1A2A3A));
+        g.fillRect(bar);
+        g.setColour(juce::Colour(0xFF4A9EBF));
+        g.fillRect(bar.withWidth(bar.getWidth() * static_cast<float>(juce::jlimit(0.0, 1.0, percent / 25.0))));
+    }
+}
+
+//==============================================================================
+DeadlineMeter::DeadlineMeter(AbyssVerbVNAudioProcessor& p)
+    : audioProcessor(p)
+{
+    summary = audioProcessor.getDeadlineMonitor().getSummary();
+    startTimerHz(4);
+}
+
+DeadlineMeter::~DeadlineMeter() { stopTimer(); }
+
+void DeadlineMeter::timerCallback()
+{
+    summary = audioProcessor.getDeadlineMonitor().getSummary();
+    repaint();
+}
+
+void DeadlineMeter::mouseDown(const juce::MouseEvent&)
+{
+    audioProcessor.getDeadlineMonitor().reset();
+    timerCallback();
+}
+
+void DeadlineMeter::paint(juce::Graphics& g)
+{
+    auto area = getLocalBounds();
+
+    g.setFont(juce::Font(9.0f));
+    g.setColour(summary.misses > 0 ? juce::Colour(0xFFCC6655)
+                : summary.nearMisses > 0 ? juce::Colour(0xFFCCAA55)
+                                         : juce::Colour(0xFF6699AA));
+    g.drawText("LOAD " + juce::String(juce::roundToInt(summary.lastLoad * 100.0f))
+                   + "%  PEAK " + juce::String(juce::roundToInt(summary.worstLoad * 100.0f))
+                   + "%  NEAR " + juce::String(static_cast<juce::int64>(summary.nearMisses))
+                   + "  MISS " + juce::String(static_cast<juce::int64>(summary.misses)),
+               area.removeFromTop(12), juce::Justification::centredLeft);
+
+    // Histogram: one column per 5 % bin, log-scaled counts; budget edges at 70 % and 100 %
+    auto strip = area.reduced(0, 2).toFloat();
+    g.setColour(juce::Colour(0xFF0D1520));
+    g.fillRect(strip);
+
+    uint32_t peak = 0;
+    for (auto b : summary.bins)
+        peak = juce::jmax(peak, b);
+
+    const float columnWidth = strip.getWidth() / static_cast<float>(DeadlineMonitor::NUM_BINS);
+    if (peak > 0)
+    {
+        const float logPeak = std::log1p(static_cast<float>(peak));
+        for (int i = 0; i < DeadlineMonitor::NUM_BINS; ++i)
+        {
+            if (summary.bins[i] == 0)
+                continue;
+            const float load = static_cast<float>(i) * DeadlineMonitor::BIN_WIDTH;
+            const float height = strip.getHeight() * std::log1p(static_cast<float>(summary.bins[i])) / logPeak;
+            g.setColour(load >= 1.0f ? juce::Colour(0xFFCC6655)
+                        : load >= summary.nearMissThreshold ? juce::Colour(0xFFCCAA55)
+                                                            : juce::Colour(0xFF4A9EBF));
+            g.fillRect(strip.getX() + static_cast<float>(i) * columnWidth, strip.getBottom() - height,
+                       juce::jmax(1.0f, columnWidth - 1.0f), height);
+        }
+    }
+
+    g.setColour(juce::Colour(0xFF3A6677));
+    for (float edge : { summary.nearMissThreshold, 1.0f })
+    {
+        const float x = strip.getX() + edge / DeadlineMonitor::BIN_WIDTH * columnWidth;
+        g.drawLine(x, strip.getY(), x, strip.getBottom(), 1.0f);
+    }
 }
@@ -2,6 +2,53 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 
+//==============================================================================
+// Per-stage CPU overlay: share of the real-time budget each processBlock
+// stage used over the last refresh interval (see StageProfiler). The total
+// includes the profiler's own counter reads; the stage rows leave them out
+//==============================================================================
+class StageProfilerOverlay : public juce::Component, private juce::Timer
+{
+public:
+    explicit StageProfilerOverlay(AbyssVerbVNAudioProcessor&);
+    ~StageProfilerOverlay() override;
+
+    void paint(juce::Graphics&) override;
+    void visibilityChanged() override;
+
+private:
+    void timerCallback() override;
+
+    AbyssVerbVNAudioProcessor& audioProcessor;
+    StageProfiler::Snapshot previous, interval;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StageProfilerOverlay)
+};
+
+//==============================================================================
+// Deadline meter: processBlock load against the real-time budget, with
+// near-miss / miss counts and the load histogram (see DeadlineMonitor).
+// Click to reset.
+//==============================================================================
+class DeadlineMeter : public juce::Component, private juce::Timer
+{
+public:
+    explicit DeadlineMeter(AbyssVerbVNAudioProcessor&);
+    ~DeadlineMeter() override;
+
+    void paint(juce::Graphics&) override;
+    void mouseDown(const juce::MouseEvent&) override;
+
+private:
+    void timerCallback() override;
+
+    AbyssVerbVNAudioProcessor& audioProcessor;
+    DeadlineMonitor::Summary summary;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeadlineMeter)
+};
+
+//==============================================================================
 class AbyssVerbVNAudioProcessorEditor : public juce::AudioProcessorEditor
 {
 public:
@@ -22,12 +69,14 @@ private:
         std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attachment;
     };
 
-    // Violin Input Conditioning (4 knobs)
+    // Violin Input Conditioning (6 knobs)
     KnobWithLabel piezoCorrectKnob, bodyResonanceKnob, brightnessKnob, bowSensitivityKnob;
+    KnobWithLabel sympatheticKnob, pitchFollowKnob;
 
-    // Abyss Reverb (6 knobs)
+    // Abyss Reverb (9 knobs)
     KnobWithLabel reverbDecayKnob, reverbDampHighKnob, reverbDampLowKnob;
     KnobWithLabel reverbModDepthKnob, reverbModRateKnob, detuneKnob;
+    KnobWithLabel diffusionKnob, preDelayKnob, shimmerKnob;
 
     // Vanishing Delay (5 knobs)
     KnobWithLabel delayTimeKnob, delayFeedbackKnob, vanishRateKnob;
@@ -36,8 +85,51 @@ private:
     // Mix (3 knobs)
     KnobWithLabel reverbMixKnob, delayMixKnob, masterMixKnob;
 
+    // Feedback suppressor toggle
+    juce::ToggleButton howlGuardButton { "HOWL GUARD" };
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> howlGuardAttachment;
+
+    // Convolution tail / freeze toggles
+    juce::ToggleButton convTailButton { "CONV TAIL" }, freezeButton { "FREEZE" };
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> convTailAttachment, freezeAttachment;
+    juce::ToggleButton tapeSatButton { "TAPE SAT" };
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> tapeSatAttachment;
+
+    // Reverb engine selector
+    juce::ComboBox engineBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> engineAttachment;
+
+    // Freeze mode / spectral hop selectors
+    juce::ComboBox freezeModeBox, spectralHopBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> freezeModeAttachment, spectralHopAttachment;
+
+    // Shimmer interval selector
+    juce::ComboBox shimmerIntervalBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> shimmerIntervalAttachment;
+
+    // Degrade oversampling selector
+    juce::ComboBox degradeOversamplingBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> degradeOversamplingAttachment;
+
+    // Pickup IR loader
+    juce::TextButton loadIRButton { "LOAD IR" }, clearIRButton { "CLEAR IR" };
+    juce::Label irNameLabel;
+    std::unique_ptr<juce::FileChooser> irChooser;
+
+    // CPU overlay toggle (also switches the processor's stage profiler)
+    juce::TextButton cpuButton { "CPU" };
+    StageProfilerOverlay cpuOverlay;
+    DeadlineMeter deadlineMeter;
+
+    // Trace recording toggle (Chrome trace JSON in the documents folder)
+    juce::TextButton traceButton { "TRACE" };
+
     void setupKnob(KnobWithLabel& knob, const juce::String& paramId,
                    const juce::String& labelText);
+    void setupIRControls();
+    void updateIRLabel();
+    void setupCpuOverlay();
+    void setupTraceButton();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AbyssVerbVNAudioProcessorEditor)
 };
@@ -8,6 +8,10 @@ AbyssVerbVNAudioProcessor::AbyssVerbVNAudioProcessor()
         .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
       apvts(*this, nullptr, "Parameters", createParameterLayout())
 {
+    // Hosts without our editor: trace from load to unload into the named file
+    const auto traceFile = juce::SystemStats::getEnvironmentVariable("ABYSS_TRACE_FILE", {});
+    if (traceFile.isNotEmpty())
+        startTrace(juce::File(traceFile));
 }
 
 AbyssVerbVNAudioProcessor::~AbyssVerbVNAudioProcessor() {}
@@ -35,6 +39,17 @@ AbyssVerbVNAudioProcessor::createParameterLayout()
         juce::ParameterID{"bowSensitivity", 1}, "Bow Sensitivity",
         juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
 
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{"feedbackSuppress", 1}, "Howl Guard", false));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{"sympathetic", 1}, "Sympathetic Strings",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{"pitchFollow", 1}, "Pitch Follow",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
+
     // === Abyss Reverb (6 params) ===
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{"reverbDecay", 1}, "Abyss Depth",
@@ -60,6 +75,40 @@ AbyssVerbVNAudioProcessor::createParameterLayout()
         juce::ParameterID{"detuneAmount", 1}, "Detune",
         juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
 
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{"diffusion", 1}, "Diffusion",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{"preDelay", 1}, "Pre-Delay",
+        juce::NormalisableRange<float>(0.0f, 250.0f, 0.1f, 0.5f), 0.0f));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"reverbEngine", 1}, "Reverb Engine",
+        juce::StringArray { "Abyss FDN", "Eco Plate" }, 0));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{"shimmer", 1}, "Shimmer",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"shimmerInterval", 1}, "Shimmer Interval",
+        juce::StringArray { "Octave", "Fifth" }, 0));
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{"convTail", 1}, "Conv Tail", false));
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{"freeze", 1}, "Freeze", false));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"freezeMode", 1}, "Freeze Mode",
+        juce::StringArray { "FDN", "Spectral" }, 0));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"spectralHop", 1}, "Spectral Hop",
+        juce::StringArray { "1024", "512", "256" }, 1));
+
     // === Vanishing Delay (5 params) ===
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{"delayTime", 1}, "Delay Time",
@@ -69,6 +118,9 @@ AbyssVerbVNAudioProcessor::createParameterLayout()
         juce::ParameterID{"delayFeedback", 1}, "Delay Feedback",
         juce::NormalisableRange<float>(0.0f, 0.95f, 0.01f), 0.5f));
 
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{"tapeSaturation", 1}, "Tape Saturation", false));
+
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{"vanishRate", 1}, "Vanish Rate",
         juce::NormalisableRange<float>(0.0f, 0.8f, 0.01f), 0.3f));
@@ -77,6 +129,10 @@ AbyssVerbVNAudioProcessor::createParameterLayout()
         juce::ParameterID{"degradeAmount", 1}, "Degrade",
         juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.3f));
 
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"degradeOversampling", 1}, "Degrade Oversampling",
+        juce::StringArray { "Off", "2x", "4x" }, 0));
+
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{"driftAmount", 1}, "Drift",
         juce::NormalisableRange<float>(0.0f, 10.0f, 0.1f), 2.0f));
@@ -100,17 +156,41 @@ AbyssVerbVNAudioProcessor::createParameterLayout()
 //==============================================================================
 void AbyssVerbVNAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
+    ABYSS_TRACE_SCOPE("prepareToPlay", "message");
+
     // Prepare all processing modules
+    feedbackSuppressor.prepare(sampleRate);
     inputConditionerL.prepare(sampleRate);
     inputConditionerR.prepare(sampleRate);
+    rebuildPickupIR(sampleRate);
     envelopeFollowerL.prepare(sampleRate);
     envelopeFollowerR.prepare(sampleRate);
+    sympatheticBank.prepare(sampleRate);
+    sympatheticRunning = false;
+    pitchTracker.prepare(sampleRate);
+    sympatheticTuning = 1.0f;
+    tuningGlide = 1.0f - std::exp(-static_cast<float>(TUNING_INTERVAL) / static_cast<float>(sampleRate * 0.05));
+    tuningCountdown = 0;
+    trackedPitch.store(0.0f);
+    diffuserL.prepare(sampleRate, 1.0f);
+    diffuserR.prepare(sampleRate, 1.07f);
     reverbL.prepare(sampleRate, samplesPerBlock);
     reverbR.prepare(sampleRate, samplesPerBlock);
+    hybridTail.prepare(sampleRate);
+    plateReverb.prepare(sampleRate);
+    plateActive = apvts.getRawParameterValue("reverbEngine")->load() > 0.5f;
+    const int spectralHop = SpectralFreeze::FFT_SIZE / 4 >> static_cast<int>(apvts.getRawParameterValue("spectralHop")->load());
+    spectralFreezeL.prepare(sampleRate, spectralHop, 0x9E3779B9u);
+    spectralFreezeR.prepare(sampleRate, spectralHop, 0x85EBCA6Bu);
     delayL.prepare(sampleRate, samplesPerBlock);
     delayR.prepare(sampleRate, samplesPerBlock);
 
+    // Everything above may allocate; from here on only state is reset
+    ABYSS_REALTIME_SECTION("prepareToPlay (state reset)");
+
     // Clear all delay lines
+    diffuserL.clear();
+    diffuserR.clear();
     reverbL.clear();
     reverbR.clear();
     delayL.clear();
@@ -138,14 +218,32 @@ void AbyssVerbVNAudioProcessor::prepareToPlay(double sampleRate, int samplesPerB
     rawParamBuffer[15] = apvts.getRawParameterValue("reverbMix")->load();
     rawParamBuffer[16] = apvts.getRawParameterValue("delayMix")->load();
     rawParamBuffer[17] = apvts.getRawParameterValue("masterMix")->load();
+    rawParamBuffer[18] = apvts.getRawParameterValue("diffusion")->load();
+    rawParamBuffer[19] = apvts.getRawParameterValue("preDelay")->load();
+    rawParamBuffer[20] = apvts.getRawParameterValue("sympathetic")->load();
+    rawParamBuffer[21] = apvts.getRawParameterValue("shimmer")->load();
     smoothed.smooth(rawParamBuffer);
 
     // Reset DC blockers
     dcBlockL_x1 = dcBlockL_y1 = 0.0f;
     dcBlockR_x1 = dcBlockR_y1 = 0.0f;
+
+    lastTailSettings = {};
+    lastModDepth = -1.0f;
+    tailStableSamples = 0;
 }
 
-void AbyssVerbVNAudioProcessor::releaseResources() {}
+void AbyssVerbVNAudioProcessor::releaseResources()
+{
+    ABYSS_TRACE_SCOPE("releaseResources", "message");
+
+    feedbackSuppressor.release();
+    hybridTail.release();
+
+    // The standalone app keeps a deadline report per audio device run
+    if (wrapperType == wrapperType_Standalone)
+        dumpDeadlineReport();
+}
 
 bool AbyssVerbVNAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
@@ -159,7 +257,14 @@ bool AbyssVerbVNAudioProcessor::isBusesLayoutSupported(const BusesLayout& layout
 void AbyssVerbVNAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                              juce::MidiBuffer& midiMessages)
 {
+    ABYSS_REALTIME_SECTION("processBlock");
+    ABYSS_TRACE_SCOPE("processBlock", "audio");
+    DeadlineMonitor::Scope deadline(deadlineMonitor, buffer.getNumSamples(), getSampleRate());
+    // ABYSS_CALLER_FPU_MODE (denormal fuzzing) keeps whatever FPU mode the caller set
+#if ! ABYSS_CALLER_FPU_MODE
     juce::ScopedNoDenormals noDenormals;
+#endif
+    StageProfiler::Block profile(stageProfiler);
 
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -186,9 +291,126 @@ void AbyssVerbVNAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     rawParamBuffer[15] = apvts.getRawParameterValue("reverbMix")->load();
     rawParamBuffer[16] = apvts.getRawParameterValue("delayMix")->load();
     rawParamBuffer[17] = apvts.getRawParameterValue("masterMix")->load();
+    rawParamBuffer[18] = apvts.getRawParameterValue("diffusion")->load();
+    rawParamBuffer[19] = apvts.getRawParameterValue("preDelay")->load();
+    rawParamBuffer[20] = apvts.getRawParameterValue("sympathetic")->load();
+    rawParamBuffer[21] = apvts.getRawParameterValue("shimmer")->load();
+
+    // Adopt any pickup IR prepared on the message thread
+    inputConditionerL.updateImpulseResponse();
+    inputConditionerR.updateImpulseResponse();
+
+    // Pick up notches published by the howl analysis thread
+    const bool suppressFeedback = apvts.getRawParameterValue("feedbackSuppress")->load() > 0.5f;
+    if (suppressFeedback)
+        feedbackSuppressor.beginBlock();
+
+    // Pitch following runs on a fixed sample grid inside the sample loop
+    const float pitchFollow = apvts.getRawParameterValue("pitchFollow")->load();
+    const bool trackPitch = pitchFollow > 0.0f;
+
+    // Convolution tail: only once decay/damping have been still and modulation is off
+    // Saturates at the 250 ms threshold so a long static session cannot overflow it
+    HybridTailReverb::Settings tailSettings { rawParamBuffer[4], rawParamBuffer[5], rawParamBuffer[6] };
+    const int tailStableThreshold = static_cast<int>(getSampleRate() * 0.25);
+    if (tailSettings != lastTailSettings || rawParamBuffer[7] != lastModDepth)
+        tailStableSamples = 0;
+    else
+        tailStableSamples = juce::jmin(tailStableSamples + buffer.getNumSamples(), tailStableThreshold);
+    lastTailSettings = tailSettings;
+    lastModDepth = rawParamBuffer[7];
+
+    const bool tailStatic = rawParamBuffer[7] == 0.0f && tailStableSamples >= tailStableThreshold;
+    // Freeze: FDN holds its current contents; new input must not go to the convolver
+    // Spectral mode leaves the FDN running and holds its output spectrum instead
+    const bool freezeOn = apvts.getRawParameterValue("freeze")->load() > 0.5f;
+    const bool spectralMode = apvts.getRawParameterValue("freezeMode")->load() > 0.5f;
+    const bool freeze = freezeOn && ! spectralMode;
+    reverbL.setFrozen(freeze);
+    reverbR.setFrozen(freeze);
+    plateReverb.setFrozen(freeze);
+
+    const int spectralHop = SpectralFreeze::FFT_SIZE / 4 >> static_cast<int>(apvts.getRawParameterValue("spectralHop")->load());
+    spectralFreezeL.setHop(spectralHop);
+    spectralFreezeR.setHop(spectralHop);
+    spectralFreezeL.setFrozen(freezeOn && spectralMode);
+    spectralFreezeR.setFrozen(freezeOn && spectralMode);
+
+    // Tape saturation in both feedback loops; a nonlinear FDN has no IR to capture
+    const bool saturation = apvts.getRawParameterValue("tapeSaturation")->load() > 0.5f;
+    reverbL.setSaturation(saturation);
+    reverbR.setSaturation(saturation);
+    delayL.setSaturation(saturation);
+    delayR.setSaturation(saturation);
+
+    // Oversampled degrade stage (choice index 0/1/2 -> factor 1/2/4)
+    const int degradeOversampling = 1 << static_cast<int>(apvts.getRawParameterValue("degradeOversampling")->load());
+    delayL.setDegradeOversampling(degradeOversampling);
+    delayR.setDegradeOversampling(degradeOversampling);
+
+    // Shimmer ratio: octave or fifth up
+    const float shimmerRatio = apvts.getRawParameterValue("shimmerInterval")->load() > 0.5f ? 1.5f : 2.0f;
+    const bool shimmer = rawParamBuffer[21] > 0.0f || smoothed.shimmer > 1.0e-4f;
+
+    // Engine switch: the newly selected engine starts from silence
+    const bool plate = apvts.getRawParameterValue("reverbEngine")->load() > 0.5f;
+    if (plate != plateActive)
+    {
+        if (plate)
+            plateReverb.clear();
+        else
+        {
+            reverbL.clear();
+            reverbR.clear();
+            hybridTail.clear();
+        }
+        plateActive = plate;
+    }
+
+    // Saturation and shimmer make the loop nonlinear / time-varying: nothing to capture
+    const bool convTail = apvts.getRawParameterValue("convTail")->load() > 0.5f;
+    hybridTail.beginBlock(convTail && ! plate && ! freeze && ! saturation && ! shimmer,
+                          tailSettings, tailStatic);
+
+    deadline.setContext((plate ? contextPlate : 0u)
+                        | (convTail && ! plate ? contextConvTail : 0u)
+                        | (freeze ? contextLoopFreeze : 0u)
+                        | (freezeOn && spectralMode ? contextSpectralFreeze : 0u)
+                        | (saturation ? contextSaturation : 0u)
+                        | (shimmer ? contextShimmer : 0u)
+                        | (degradeOversampling == 2 ? contextDegradeOS2x : 0u)
+                        | (degradeOversampling == 4 ? contextDegradeOS4x : 0u)
+                        | (suppressFeedback ? contextHowlGuard : 0u)
+                        | (trackPitch ? contextPitchFollow : 0u)
+                        | (rawParamBuffer[20] > 0.0f || sympatheticRunning ? contextSympathetic : 0u)
+                        | (inputConditionerL.hasImpulseResponse() ? contextPickupIR : 0u)
+                        | (stageProfiler.isEnabled() ? contextStageProfiler : 0u));
+
+    const BlockFlags flags { suppressFeedback, trackPitch, pitchFollow };
+    if (plate)
+    {
+        PlateReverbEngine engine { plateReverb };
+        renderSamples(buffer, engine, flags, profile);
+    }
+    else
+    {
+        FDNReverbEngine engine { reverbL, reverbR, hybridTail, shimmerRatio };
+        renderSamples(buffer, engine, flags, profile);
+    }
+}
+
+template <typename ReverbEngine>
+void AbyssVerbVNAudioProcessor::renderSamples(juce::AudioBuffer<float>& buffer, ReverbEngine& engine,
+                                              const BlockFlags& flags, StageProfiler::Block& profile)
+{
+    profile.lap(StageProfiler::setup);
+    profile.addSamples(buffer.getNumSamples());
+
+    const bool suppressFeedback = flags.suppressFeedback;
+    const bool trackPitch = flags.trackPitch;
 
     auto* channelL = buffer.getWritePointer(0);
-    auto* channelR = buffer.getWritePointer(totalNumInputChannels > 1 ? 1 : 0);
+    auto* channelR = buffer.getWritePointer(getTotalNumInputChannels() > 1 ? 1 : 0);
 
     for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
     {
@@ -200,40 +422,92 @@ void AbyssVerbVNAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         inputConditionerR.setParameters(smoothed.piezoCorrect, smoothed.bodyResonance, smoothed.brightness);
         envelopeFollowerL.setSensitivity(smoothed.bowSensitivity);
         envelopeFollowerR.setSensitivity(smoothed.bowSensitivity);
-        reverbL.setParameters(smoothed.reverbDecay, smoothed.reverbDampHigh, smoothed.reverbDampLow,
-                             smoothed.reverbModDepth, smoothed.reverbModRate, smoothed.detuneAmount);
-        reverbR.setParameters(smoothed.reverbDecay, smoothed.reverbDampHigh, smoothed.reverbDampLow,
-                             smoothed.reverbModDepth, smoothed.reverbModRate, smoothed.detuneAmount);
+        diffuserL.setAmount(smoothed.diffusion);
+        diffuserR.setAmount(smoothed.diffusion);
+        engine.setParameters(smoothed);
         delayL.setParameters(smoothed.delayTime, smoothed.delayFeedback,
                             smoothed.vanishRate, smoothed.degradeAmount, smoothed.driftAmount);
         delayR.setParameters(smoothed.delayTime * 1.07f, smoothed.delayFeedback,
                             smoothed.vanishRate, smoothed.degradeAmount, smoothed.driftAmount * 1.15f);
+        profile.lap(StageProfiler::parameters);
 
         // Store original dry signal
         float dryL = channelL[sample];
         float dryR = channelR[sample];
 
+        // Feedback suppression ahead of everything (dry path included)
+        if (suppressFeedback)
+            feedbackSuppressor.process(dryL, dryR);
+
         // Input conditioning (piezo correction)
         float conditionedL = inputConditionerL.process(dryL);
         float conditionedR = inputConditionerR.process(dryR);
+        profile.lap(StageProfiler::conditioning);
 
         // Envelope following (for potential dynamic modulation)
         float envL = envelopeFollowerL.process(conditionedL);
         float envR = envelopeFollowerR.process(conditionedR);
 
+        // Fundamental tracking (decimated, hop-rate analysis)
+        if (trackPitch)
+            pitchTracker.process(0.5f * (conditionedL + conditionedR));
+
+        // Control rate independent of the host's block size
+        if (--tuningCountdown <= 0)
+        {
+            tuningCountdown = TUNING_INTERVAL;
+            updateSympatheticTuning(flags.pitchFollow);
+        }
+        profile.lap(StageProfiler::envelope);
+
+        // Sympathetic strings: skipped entirely (and cleared on re-entry) at zero mix
+        if (smoothed.sympathetic > 1.0e-4f)
+        {
+            if (! sympatheticRunning)
+            {
+                sympatheticBank.clear();
+                sympatheticRunning = true;
+            }
+
+            float ringL, ringR;
+            sympatheticBank.process(conditionedL, conditionedR, ringL, ringR);
+            conditionedL += ringL * smoothed.sympathetic;
+            conditionedR += ringR * smoothed.sympathetic;
+        }
+        else
+        {
+            sympatheticRunning = false;
+        }
+        profile.lap(StageProfiler::sympathetic);
+
         // Signal flow: Input -> Delay -> Reverb -> Mix
         float delOutL = delayL.process(conditionedL);
         float delOutR = delayR.process(conditionedR);
 
-        float reverbInL = conditionedL + delOutL * smoothed.delayMix;
-        float reverbInR = conditionedR + delOutR * smoothed.delayMix;
-
-        float revOutL = reverbL.process(reverbInL);
-        float revOutR = reverbR.process(reverbInR);
+        // Pre-delay: conditioned input from the delay's own ring (echoes are already late)
+        float preDelayedL = conditionedL;
+        float preDelayedR = conditionedR;
+        if (smoothed.preDelay > 0.01f)
+        {
+            float preDelaySamples = smoothed.preDelay * static_cast<float>(getSampleRate()) / 1000.0f;
+            preDelayedL = delayL.readInput(preDelaySamples);
+            preDelayedR = delayR.readInput(preDelaySamples);
+        }
+        profile.lap(StageProfiler::delay);
+
+        float reverbInL = diffuserL.process(preDelayedL + delOutL * smoothed.delayMix);
+        float reverbInR = diffuserR.process(preDelayedR + delOutR * smoothed.delayMix);
+
+        float revOutL, revOutR;
+        engine.process(reverbInL, reverbInR, revOutL, revOutR);
+        revOutL = spectralFreezeL.process(revOutL);
+        revOutR = spectralFreezeR.process(revOutR);
+        profile.lap(StageProfiler::reverb);
 
         // Combine wet signals
         float wetL = revOutL * smoothed.reverbMix + delOutL * smoothed.delayMix;
         float wetR = revOutR * smoothed.reverbMix + delOutR * smoothed.delayMix;
+        profile.lap(StageProfiler::mix);
 
         // DC blocking (prevents offset accumulation)
         const float dcCoeff = 0.995f;
@@ -246,11 +520,37 @@ void AbyssVerbVNAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         dcBlockR_x1 = wetR;
         dcBlockR_y1 = dcOutR;
         wetR = dcOutR;
+        profile.lap(StageProfiler::dcBlock);
 
         // Dry/wet mix
         channelL[sample] = dryL * (1.0f - smoothed.masterMix) + wetL * smoothed.masterMix;
         channelR[sample] = dryR * (1.0f - smoothed.masterMix) + wetR * smoothed.masterMix;
+        profile.lap(StageProfiler::mix);
+    }
+}
+
+// Pitch following: glide the sympathetic strings toward the played note (~50 ms)
+void AbyssVerbVNAudioProcessor::updateSympatheticTuning(float pitchFollow)
+{
+    float tuningTarget = sympatheticTuning;
+    if (pitchFollow <= 0.0f)
+    {
+        tuningTarget = 1.0f;
+        trackedPitch.store(0.0f, std::memory_order_relaxed);
+    }
+    else if (pitchTracker.isVoiced())
+    {
+        const float semitones = SympatheticResonator::intervalToNearestString(pitchTracker.getFrequency());
+        tuningTarget = std::exp2(semitones * pitchFollow / 12.0f);
+        trackedPitch.store(pitchTracker.getFrequency(), std::memory_order_relaxed);
+    }
+    else
+    {
+        trackedPitch.store(0.0f, std::memory_order_relaxed);   // Hold the last tuning through rests
     }
+
+    sympatheticTuning += (tuningTarget - sympatheticTuning) * tuningGlide;
+    sympatheticBank.setTuning(sympatheticTuning);
 }
 
 //==============================================================================
@@ -273,8 +573,246 @@ void AbyssVerbVNAudioProcessor::setCurrentProgram(int) {}
 const juce::String AbyssVerbVNAudioProcessor::getProgramName(int) { return {}; }
 void AbyssVerbVNAudioProcessor::changeProgramName(int, const juce::String&) {}
 
+//==============================================================================
+bool AbyssVerbVNAudioProcessor::loadPickupIR(const juce::File& file)
+{
+    ABYSS_TRACE_SCOPE("loadPickupIR", "message");
+
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+        return false;
+
+    // Read up to MAX_IR_SECONDS and fold to mono
+    const int numSamples = static_cast<int>(juce::jmin<juce::int64>(
+        reader->lengthInSamples,
+        static_cast<juce::int64>(reader->sampleRate * PickupIRConvolver::MAX_IR_SECONDS)));
+    const int numChannels = static_cast<int>(reader->numChannels);
+
+    juce::AudioBuffer<float> fileBuffer(numChannels, numSamples);
+    reader->read(&fileBuffer, 0, numSamples, 0, true, true);
+
+    juce::AudioBuffer<float> mono(1, numSamples);
+    mono.clear();
+    for (int ch = 0; ch < numChannels; ++ch)
+        mono.addFrom(0, 0, fileBuffer, ch, 0, numSamples, 1.0f / static_cast<float>(numChannels));
+
+    double sampleRate = 0.0;
+    {
+        const juce::ScopedLock lock(pickupIRLock);
+        pickupIRSource = std::move(mono);
+        pickupIRSourceRate = reader->sampleRate;
+        pickupIRFile = file;
+        sampleRate = preparedSampleRate;
+    }
+
+    apvts.state.setProperty("pickupIR", file.getFullPathName(), nullptr);
+
+    // Before prepareToPlay the engines are built there instead
+    if (sampleRate > 0.0)
+        rebuildPickupIR(sampleRate);
+
+    return true;
+}
+
+void AbyssVerbVNAudioProcessor::clearPickupIR()
+{
+    {
+        const juce::ScopedLock lock(pickupIRLock);
+        pickupIRSource.setSize(0, 0);
+        pickupIRSourceRate = 0.0;
+        pickupIRFile = juce::File();
+    }
+
+    apvts.state.setProperty("pickupIR", juce::String(), nullptr);
+
+    inputConditionerL.setImpulseResponse(nullptr);
+    inputConditionerR.setImpulseResponse(nullptr);
+}
+
+juce::File AbyssVerbVNAudioProcessor::getPickupIRFile() const
+{
+    const juce::ScopedLock lock(pickupIRLock);
+    return pickupIRFile;
+}
+
+void AbyssVerbVNAudioProcessor::rebuildPickupIR(double sampleRate)
+{
+    const juce::ScopedLock lock(pickupIRLock);
+    preparedSampleRate = sampleRate;
+
+    if (pickupIRSource.getNumSamples() == 0 || pickupIRSourceRate <= 0.0)
+        return;
+
+    // Resample to the processing rate
+    const double ratio = pickupIRSourceRate / sampleRate;
+    const int srcLength = pickupIRSource.getNumSamples();
+    const int length = juce::jmin(static_cast<int>(std::ceil(srcLength / ratio)),
+                                  static_cast<int>(sampleRate * PickupIRConvolver::MAX_IR_SECONDS));
+
+    // Pad the source so the interpolator never reads past the end
+    std::vector<float> padded(static_cast<size_t>(srcLength + 8), 0.0f);
+    std::copy(pickupIRSource.getReadPointer(0), pickupIRSource.getReadPointer(0) + srcLength, padded.begin());
+
+    std::vector<float> ir(static_cast<size_t>(length), 0.0f);
+    juce::LagrangeInterpolator interpolator;
+    interpolator.process(ratio, padded.data(), ir.data(), length);
+
+    // Unit-energy normalisation keeps the corrected level close to the dry pickup
+    double energy = 0.0;
+    for (float s : ir)
+        energy += static_cast<double>(s) * s;
+    if (energy > 0.0)
+    {
+        const float gain = static_cast<float>(1.0 / std::sqrt(energy));
+        for (float& s : ir)
+            s *= gain;
+    }
+
+    // FFT plan and partitions are built here, off the audio thread
+    auto kernel = std::make_shared<const PickupIRConvolver::Kernel>(ir.data(), length);
+    inputConditionerL.setImpulseResponse(std::make_unique<PickupIRConvolver::Engine>(kernel));
+    inputConditionerR.setImpulseResponse(std::make_unique<PickupIRConvolver::Engine>(kernel));
+}
+
+//==============================================================================
+void AbyssVerbVNAudioProcessor::probeState(StateProbe& probe) const
+{
+    probe.beginModule("smoothed");
+    smoothed.probeState(probe);
+    probe.beginModule("feedbackSuppressor");
+    feedbackSuppressor.probeState(probe);
+    probe.beginModule("inputConditionerL");
+    inputConditionerL.probeState(probe);
+    probe.beginModule("inputConditionerR");
+    inputConditionerR.probeState(probe);
+    probe.beginModule("envelopeFollowerL");
+    envelopeFollowerL.probeState(probe);
+    probe.beginModule("envelopeFollowerR");
+    envelopeFollowerR.probeState(probe);
+    probe.beginModule("sympatheticBank");
+    sympatheticBank.probeState(probe);
+    probe.beginModule("pitchTracker");
+    pitchTracker.probeState(probe);
+    probe.beginModule("diffuserL");
+    diffuserL.probeState(probe);
+    probe.beginModule("diffuserR");
+    diffuserR.probeState(probe);
+    probe.beginModule("reverbL");
+    reverbL.probeState(probe);
+    probe.beginModule("reverbR");
+    reverbR.probeState(probe);
+    probe.beginModule("hybridTail");
+    hybridTail.probeState(probe);
+    probe.beginModule("plateReverb");
+    plateReverb.probeState(probe);
+    probe.beginModule("spectralFreezeL");
+    spectralFreezeL.probeState(probe);
+    probe.beginModule("spectralFreezeR");
+    spectralFreezeR.probeState(probe);
+    probe.beginModule("delayL");
+    delayL.probeState(probe);
+    probe.beginModule("delayR");
+    delayR.probeState(probe);
+
+    probe.beginModule("dcBlocker");
+    probe.visit("dcBlockL_x1", dcBlockL_x1);
+    probe.visit("dcBlockL_y1", dcBlockL_y1);
+    probe.visit("dcBlockR_x1", dcBlockR_x1);
+    probe.visit("dcBlockR_y1", dcBlockR_y1);
+}
+
+//==============================================================================
+bool AbyssVerbVNAudioProcessor::startTrace(const juce::File& file)
+{
+    return traceSession.start(file);
+}
+
+void AbyssVerbVNAudioProcessor::stopTrace()
+{
+    traceSession.stop();
+}
+
+//==============================================================================
+juce::StringArray AbyssVerbVNAudioProcessor::describeDeadlineContext(uint32_t context)
+{
+    static const char* const names[] = { "plate", "convTail", "loopFreeze", "spectralFreeze", "saturation",
+                                         "shimmer", "degradeOS2x", "degradeOS4x", "howlGuard", "pitchFollow",
+                                         "sympathetic", "pickupIR", "stageProfiler" };
+    juce::StringArray result;
+    for (int bit = 0; bit < static_cast<int>(std::size(names)); ++bit)
+        if (context & (1u << bit))
+            result.add(names[bit]);
+    return result;
+}
+
+juce::String AbyssVerbVNAudioProcessor::getDeadlineReport() const
+{
+    const auto summary = deadlineMonitor.getSummary();
+
+    auto* report = new juce::DynamicObject();
+    report->setProperty("plugin", JucePlugin_Name);
+    report->setProperty("sampleRate", getSampleRate());
+    report->setProperty("blockSize", getBlockSize());
+    report->setProperty("blocks", static_cast<juce::int64>(summary.blocks));
+    report->setProperty("nearMissThreshold", summary.nearMissThreshold);
+    report->setProperty("nearMisses", static_cast<juce::int64>(summary.nearMisses));
+    report->setProperty("misses", static_cast<juce::int64>(summary.misses));
+    report->setProperty("worstLoad", summary.worstLoad);
+    report->setProperty("p50Load", summary.getLoadPercentile(0.5));
+    report->setProperty("p99Load", summary.getLoadPercentile(0.99));
+
+    // Histogram: block counts per load bin, bins keyed by their lower edge in percent
+    juce::Array<juce::var> histogram;
+    for (int i = 0; i < DeadlineMonitor::NUM_BINS; ++i)
+    {
+        if (summary.bins[i] == 0)
+            continue;
+        auto* bin = new juce::DynamicObject();
+        bin->setProperty("fromPercent", juce::roundToInt(static_cast<float>(i) * DeadlineMonitor::BIN_WIDTH * 100.0f));
+        bin->setProperty("blocks", static_cast<juce::int64>(summary.bins[i]));
+        histogram.add(juce::var(bin));
+    }
+    report->setProperty("histogram", histogram);
+
+    DeadlineMonitor::Event events[DeadlineMonitor::NUM_EVENTS];
+    const int numEvents = deadlineMonitor.getRecentEvents(events);
+    juce::Array<juce::var> recent;
+    for (int i = 0; i < numEvents; ++i)
+    {
+        auto* event = new juce::DynamicObject();
+        event->setProperty("time", events[i].time);
+        event->setProperty("load", events[i].load);
+        event->setProperty("numSamples", events[i].numSamples);
+        event->setProperty("sampleRate", events[i].sampleRate);
+        event->setProperty("features", describeDeadlineContext(events[i].context).joinIntoString(","));
+        recent.add(juce::var(event));
+    }
+    report->setProperty("recentEvents", recent);
+
+    return juce::JSON::toString(juce::var(report));
+}
+
+void AbyssVerbVNAudioProcessor::dumpDeadlineReport()
+{
+    if (deadlineMonitor.getSummary().blocks == 0)
+        return;
+
+    const auto folder = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                            .getChildFile(JucePlugin_Name).getChildFile("Deadlines");
+    const auto file = folder.getChildFile("deadlines-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S") + ".json");
+    if (folder.createDirectory())
+        file.replaceWithText(getDeadlineReport());
+
+    deadlineMonitor.reset();
+}
+
 void AbyssVerbVNAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
+    ABYSS_TRACE_SCOPE("getStateInformation", "message");
+
     auto state = apvts.copyState();
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
     copyXmlToBinary(*xml, destData);
@@ -282,10 +820,21 @@ void AbyssVerbVNAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 
 void AbyssVerbVNAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
+    ABYSS_TRACE_SCOPE("setStateInformation", "message");
+
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
     if (xmlState.get() != nullptr)
         if (xmlState->hasTagName(apvts.state.getType()))
+        {
             apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+
+            // Restore the per-instrument pickup IR, if one was saved
+            juce::String irPath = apvts.state.getProperty("pickupIR").toString();
+            if (irPath.isNotEmpty() && juce::File(irPath).existsAsFile())
+                loadPickupIR(juce::File(irPath));
+            else
+                clearPickupIR();
+        }
 }
 
 //==============================================================================
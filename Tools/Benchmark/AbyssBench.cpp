@@ -0,0 +1,480 @@
+//==============================================================================
+// AbyssBench: per-module and full-chain throughput benchmark
+//
+// Each case runs the stereo configuration the processor itself uses (two
+// conditioners, two followers, two FDNs / one plate, two delays, one
+// smoother) with the same per-sample parameter updates as renderSamples, so
+// "ns/sample" is per stereo frame and the module figures add up to roughly
+// the chain figure. Results go to JSON; see --help.
+//==============================================================================
+
+#include "AbyssDSP.h"
+#include "../Common/InstructionCounter.h"
+#include "../Common/ToolSupport.h"
+
+#if ABYSS_WITH_PROCESSOR
+ #include "PluginProcessor.h"
+#endif
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+
+using namespace AbyssTools;
+
+namespace
+{
+
+//==============================================================================
+class BenchModule
+{
+public:
+    virtual ~BenchModule() = default;
+    virtual void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) = 0;
+};
+
+class ConditionerBench : public BenchModule
+{
+public:
+    explicit ConditionerBench(double sr) { left.prepare(sr); right.prepare(sr); }
+
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            left.setParameters(params.piezoCorrect, params.bodyResonance, params.brightness);
+            right.setParameters(params.piezoCorrect, params.bodyResonance, params.brightness);
+            outL[i] = left.process(inL[i]);
+            outR[i] = right.process(inR[i]);
+        }
+    }
+
+private:
+    ViolinInputConditioner left, right;
+    SmoothedParameters params;
+};
+
+class FollowerBench : public BenchModule
+{
+public:
+    explicit FollowerBench(double sr) { left.prepare(sr); right.prepare(sr); }
+
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            left.setSensitivity(params.bowSensitivity);
+            right.setSensitivity(params.bowSensitivity);
+            outL[i] = left.process(inL[i]);
+            outR[i] = right.process(inR[i]);
+        }
+    }
+
+private:
+    EnvelopeFollower left, right;
+    SmoothedParameters params;
+};
+
+class FDNBench : public BenchModule
+{
+public:
+    FDNBench(double sr, int blockSize)
+    {
+        left.prepare(sr, blockSize);
+        right.prepare(sr, blockSize);
+        left.clear();
+        right.clear();
+    }
+
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            left.setParameters(params.reverbDecay, params.reverbDampHigh, params.reverbDampLow,
+                               params.reverbModDepth, params.reverbModRate, params.detuneAmount);
+            right.setParameters(params.reverbDecay, params.reverbDampHigh, params.reverbDampLow,
+                                params.reverbModDepth, params.reverbModRate, params.detuneAmount);
+            left.setShimmer(params.shimmer, 2.0f);
+            right.setShimmer(params.shimmer, 2.0f);
+            outL[i] = left.process(inL[i]);
+            outR[i] = right.process(inR[i]);
+        }
+    }
+
+private:
+    AbyssFDNReverb left, right;
+    SmoothedParameters params;
+};
+
+class PlateBench : public BenchModule
+{
+public:
+    explicit PlateBench(double sr)
+    {
+        plate.prepare(sr);
+        plate.clear();
+    }
+
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            plate.setParameters(params.reverbDecay, params.reverbDampHigh, params.reverbDampLow,
+                                params.reverbModDepth, params.reverbModRate, params.detuneAmount);
+            plate.process(inL[i], inR[i], outL[i], outR[i]);
+        }
+    }
+
+private:
+    DattorroPlate plate;
+    SmoothedParameters params;
+};
+
+class DelayBench : public BenchModule
+{
+public:
+    DelayBench(double sr, int blockSize)
+    {
+        left.prepare(sr, blockSize);
+        right.prepare(sr, blockSize);
+        left.clear();
+        right.clear();
+    }
+
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            left.setParameters(params.delayTime, params.delayFeedback,
+                               params.vanishRate, params.degradeAmount, params.driftAmount);
+            right.setParameters(params.delayTime * 1.07f, params.delayFeedback,
+                                params.vanishRate, params.degradeAmount, params.driftAmount * 1.15f);
+            outL[i] = left.process(inL[i]);
+            outR[i] = right.process(inR[i]);
+        }
+    }
+
+private:
+    VanishingDelay left, right;
+    SmoothedParameters params;
+};
+
+// Raw targets alternate every block, like continuous automation
+class SmootherBench : public BenchModule
+{
+public:
+    explicit SmootherBench(double sr)
+    {
+        params.reset(static_cast<float>(sr));
+        for (int i = 0; i < SmoothedParameters::NUM_PARAMS; ++i)
+        {
+            rawA[i] = 0.25f + 0.01f * static_cast<float>(i);
+            rawB[i] = 0.75f - 0.01f * static_cast<float>(i);
+        }
+    }
+
+    void process(const float*, const float*, float* outL, float* outR, int numSamples) override
+    {
+        const float* raw = (++blockCount & 1) ? rawA : rawB;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            params.smooth(raw);
+            outL[i] = params.reverbDecay;
+            outR[i] = params.masterMix;
+        }
+    }
+
+private:
+    SmoothedParameters params;
+    float rawA[SmoothedParameters::NUM_PARAMS] = {};
+    float rawB[SmoothedParameters::NUM_PARAMS] = {};
+    uint32_t blockCount = 0;
+};
+
+#if ABYSS_WITH_PROCESSOR
+// Full chain through processBlock, default parameters
+class ProcessorBench : public BenchModule
+{
+public:
+    ProcessorBench(double sr, int blockSize) : buffer(2, blockSize)
+    {
+        processor.setPlayConfigDetails(2, 2, sr, blockSize);
+        processor.prepareToPlay(sr, blockSize);
+    }
+
+    ~ProcessorBench() override { processor.releaseResources(); }
+
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) override
+    {
+        buffer.setSize(2, numSamples, false, false, true);
+        buffer.copyFrom(0, 0, inL, numSamples);
+        buffer.copyFrom(1, 0, inR, numSamples);
+        processor.processBlock(buffer, midi);
+        std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + numSamples, outL);
+        std::copy(buffer.getReadPointer(1), buffer.getReadPointer(1) + numSamples, outR);
+    }
+
+private:
+    AbyssVerbVNAudioProcessor processor;
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+};
+#endif
+
+std::unique_ptr<BenchModule> createModule(const std::string& name, double sr, int blockSize)
+{
+    if (name == "conditioner") return std::make_unique<ConditionerBench>(sr);
+    if (name == "follower")    return std::make_unique<FollowerBench>(sr);
+    if (name == "fdn")         return std::make_unique<FDNBench>(sr, blockSize);
+    if (name == "plate")       return std::make_unique<PlateBench>(sr);
+    if (name == "delay")       return std::make_unique<DelayBench>(sr, blockSize);
+    if (name == "smoother")    return std::make_unique<SmootherBench>(sr);
+   #if ABYSS_WITH_PROCESSOR
+    if (name == "processor")   return std::make_unique<ProcessorBench>(sr, blockSize);
+   #endif
+    return nullptr;
+}
+
+//==============================================================================
+struct CaseResult
+{
+    std::string module;
+    double sampleRate = 0.0;
+    int blockSize = 0;
+    double nsPerSample = 0.0;
+    double instructionsPerSample = -1.0;   // < 0: counter unavailable
+};
+
+struct Run
+{
+    double nsPerSample;
+    double instructionsPerSample;
+};
+
+class Benchmark
+{
+public:
+    Benchmark(double secondsPerCase, int numRepeats)
+        : seconds(secondsPerCase), repeats(numRepeats) {}
+
+    bool hasInstructionCounter() const { return counter.isAvailable(); }
+
+    CaseResult run(const std::string& name, double sr, int blockSize)
+    {
+        CaseResult result;
+        result.module = name;
+        result.sampleRate = sr;
+        result.blockSize = blockSize;
+
+        auto module = createModule(name, sr, blockSize);
+        if (module == nullptr)
+            return result;
+
+        // One second of input, cycled block by block
+        const int inputLength = juce::jmax(blockSize, static_cast<int>(sr) / blockSize * blockSize);
+        std::vector<float> inL(static_cast<size_t>(inputLength)), inR(static_cast<size_t>(inputLength));
+        TestSignal(sr).fill(inL.data(), inR.data(), inputLength);
+        std::vector<float> outL(static_cast<size_t>(blockSize)), outR(static_cast<size_t>(blockSize));
+
+        const juce::ScopedNoDenormals noDenormals;
+        int cursor = 0;
+        auto processBlocks = [&](int64_t numBlocks)
+        {
+            for (int64_t b = 0; b < numBlocks; ++b)
+            {
+                module->process(inL.data() + cursor, inR.data() + cursor, outL.data(), outR.data(), blockSize);
+                sink += outL[0] + outR[static_cast<size_t>(blockSize - 1)];
+                cursor += blockSize;
+                if (cursor + blockSize > inputLength)
+                    cursor = 0;
+            }
+        };
+
+        // Warm-up: a quarter second of audio (caches, branch predictors, tails)
+        processBlocks(juce::jmax<int64_t>(1, static_cast<int64_t>(sr * 0.25) / blockSize));
+
+        // Calibrate the block count to the time budget of one repeat
+        const double budgetPerRepeat = seconds / repeats;
+        int64_t numBlocks = 1;
+        for (;;)
+        {
+            const double elapsed = timeBlocks(processBlocks, numBlocks).first;
+            if (elapsed >= budgetPerRepeat * 0.5 || numBlocks > (int64_t(1) << 30))
+            {
+                numBlocks = juce::jmax<int64_t>(1, static_cast<int64_t>(static_cast<double>(numBlocks) * budgetPerRepeat / juce::jmax(elapsed, 1.0e-9)));
+                break;
+            }
+            numBlocks *= 2;
+        }
+
+        std::vector<Run> runs;
+        const double samples = static_cast<double>(numBlocks) * blockSize;
+        for (int r = 0; r < repeats; ++r)
+        {
+            const auto timed = timeBlocks(processBlocks, numBlocks);
+            runs.push_back({ timed.first * 1.0e9 / samples,
+                             counter.isAvailable() ? static_cast<double>(timed.second) / samples : -1.0 });
+        }
+
+        // Median run: robust against a preempted repeat
+        std::sort(runs.begin(), runs.end(), [](const Run& a, const Run& b) { return a.nsPerSample < b.nsPerSample; });
+        const Run& median = runs[runs.size() / 2];
+        result.nsPerSample = median.nsPerSample;
+        result.instructionsPerSample = median.instructionsPerSample;
+        return result;
+    }
+
+    float getSink() const { return sink; }
+
+private:
+    template <typename Fn>
+    std::pair<double, uint64_t> timeBlocks(Fn&& processBlocks, int64_t numBlocks)
+    {
+        counter.start();
+        const auto start = std::chrono::steady_clock::now();
+        processBlocks(numBlocks);
+        const auto end = std::chrono::steady_clock::now();
+        const uint64_t instructions = counter.stop();
+        return { std::chrono::duration<double>(end - start).count(), instructions };
+    }
+
+    double seconds;
+    int repeats;
+    InstructionCounter counter;
+    float sink = 0.0f;   // Keeps the optimiser from discarding the work
+};
+
+void printUsage()
+{
+    std::cout <<
+        "AbyssBench [options]\n"
+        "  --modules a,b,..   conditioner,follower,fdn,plate,delay,smoother"
+       #if ABYSS_WITH_PROCESSOR
+        ",processor"
+       #endif
+        " (default: all)\n"
+        "  --rates r1,r2,..   sample rates (default 44100,48000,88200,96000,192000)\n"
+        "  --blocks b1,b2,..  block sizes (default 16,32,64,128,256,512,1024,2048,4096)\n"
+        "  --seconds s        measured time per case (default 0.25)\n"
+        "  --repeats n        repeats per case, median reported (default 5)\n"
+        "  --quick            48 kHz, blocks 64,512,4096, 0.05 s per case\n"
+        "  --output file      JSON report (default: stdout)\n";
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    Arguments args(argc, argv);
+    if (args.has("--help"))
+    {
+        printUsage();
+        return 0;
+    }
+
+   #if ABYSS_WITH_PROCESSOR
+    const juce::ScopedJuceInitialiser_GUI juceInit;   // APVTS needs a message manager
+   #endif
+
+    std::vector<std::string> allModules { "conditioner", "follower", "fdn", "plate", "delay", "smoother" };
+   #if ABYSS_WITH_PROCESSOR
+    allModules.push_back("processor");
+   #endif
+
+    const bool quick = args.has("--quick");
+    const auto modules = args.getNames("--modules", allModules);
+    const auto rates = args.getList("--rates", quick ? std::vector<double> { 48000.0 }
+                                                     : std::vector<double> { 44100.0, 48000.0, 88200.0, 96000.0, 192000.0 });
+    const auto blocks = args.getList("--blocks", quick ? std::vector<double> { 64.0, 512.0, 4096.0 }
+                                                       : std::vector<double> { 16.0, 32.0, 64.0, 128.0, 256.0, 512.0, 1024.0, 2048.0, 4096.0 });
+    const double seconds = args.getDouble("--seconds", quick ? 0.05 : 0.25);
+    const int repeats = juce::jmax(1, static_cast<int>(args.getDouble("--repeats", 5.0)));
+
+    for (const auto& name : modules)
+    {
+        if (createModule(name, 48000.0, 64) == nullptr)
+        {
+            std::cerr << "Unknown module: " << name << "\n";
+            return 1;
+        }
+    }
+
+    Benchmark bench(seconds, repeats);
+    std::vector<CaseResult> results;
+    for (const auto& name : modules)
+    {
+        for (double sr : rates)
+        {
+            for (double block : blocks)
+            {
+                results.push_back(bench.run(name, sr, static_cast<int>(block)));
+                const auto& r = results.back();
+                std::cerr << name << " @ " << sr << " Hz, " << r.blockSize << " samples: "
+                          << r.nsPerSample << " ns/sample\n";
+            }
+        }
+    }
+
+    // Plate vs FDN cost, wherever both were measured
+    std::map<std::pair<double, int>, double> fdnCost;
+    for (const auto& r : results)
+        if (r.module == "fdn")
+            fdnCost[{ r.sampleRate, r.blockSize }] = r.nsPerSample;
+
+    std::vector<double> ratios;
+    const bool written = writeReport(args.get("--output"), [&](JsonWriter& json)
+    {
+        json.beginObject();
+        json.field("benchmark", "AbyssBench");
+        json.key("config").beginObject()
+            .field("secondsPerCase", seconds)
+            .field("repeats", repeats)
+            .field("instructionCounter", bench.hasInstructionCounter())
+            .field("sampleUnit", "stereo frame")
+            .endObject();
+
+        json.key("results").beginArray();
+        for (const auto& r : results)
+        {
+            json.beginObject()
+                .field("module", r.module)
+                .field("sampleRate", r.sampleRate)
+                .field("blockSize", r.blockSize)
+                .field("nsPerSample", r.nsPerSample)
+                .field("samplesPerSecond", 1.0e9 / r.nsPerSample)
+                .field("realtimeFactor", 1.0e9 / r.nsPerSample / r.sampleRate);
+            json.key("instructionsPerSample");
+            if (r.instructionsPerSample >= 0.0) json.value(r.instructionsPerSample);
+            else                                json.null();
+            json.endObject();
+        }
+        json.endArray();
+
+        json.key("plateToFdnCostRatio").beginArray();
+        for (const auto& r : results)
+        {
+            auto fdn = fdnCost.find({ r.sampleRate, r.blockSize });
+            if (r.module != "plate" || fdn == fdnCost.end())
+                continue;
+
+            ratios.push_back(r.nsPerSample / fdn->second);
+            json.beginObject()
+                .field("sampleRate", r.sampleRate)
+                .field("blockSize", r.blockSize)
+                .field("ratio", ratios.back())
+                .endObject();
+        }
+        json.endArray();
+
+        json.key("plateToFdnCostRatioMedian");
+        if (ratios.empty()) json.null();
+        else                json.value(percentile(ratios, 50.0));
+
+        json.field("sink", static_cast<double>(bench.getSink()));
+        json.endObject();
+    });
+
+    return written ? 0 : 1;
+}
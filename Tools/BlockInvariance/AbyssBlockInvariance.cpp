@@ -0,0 +1,320 @@
+//==============================================================================
+// AbyssBlockInvariance: block-size invariance test for processBlock
+//
+// Renders the same input and parameter timeline through a fresh processor
+// with 1-, 32-, 512- and variable-sized blocks and diffs every rendering
+// against the 1-sample one.
+//
+//   split mode      blocks are cut at every parameter event, as sample-accurate
+//                   hosts do; output must match within --tolerance (the
+//                   guarantee documented on AbyssVerbVNAudioProcessor::processBlock)
+//   quantised mode  events take effect at the next block start, as most hosts
+//                   deliver automation; deviation is reported, and enforced
+//                   only when --quantised-tolerance is given
+//
+// The convolution tail and howl guard engage on worker-thread timing and are
+// held off; everything else, including the freeze modes, engine switches,
+// pitch following and oversampling, is exercised.
+//==============================================================================
+
+#include "PluginProcessor.h"
+#include "../Common/ParameterDriver.h"
+#include "../Common/ToolSupport.h"
+
+#include <functional>
+#include <memory>
+
+using namespace AbyssTools;
+
+namespace
+{
+
+//==============================================================================
+struct Event
+{
+    int64_t position;
+    std::function<void(ParameterDriver&)> apply;
+};
+
+struct Timeline
+{
+    std::string name, description;
+    std::vector<Event> events;     // Sorted by position; position 0 sets the initial state
+};
+
+// Worker-thread features are outside the guarantee
+void holdExemptFeaturesOff(ParameterDriver& params)
+{
+    params.setNormalised("convTail", 0.0f);
+    params.setNormalised("feedbackSuppress", 0.0f);
+}
+
+std::vector<Timeline> createTimelines(double sr, int64_t length)
+{
+    std::vector<Timeline> timelines;
+
+    timelines.push_back({ "defaults", "Default parameters, no automation",
+        { { 0, [](ParameterDriver& p) { holdExemptFeaturesOff(p); } } } });
+
+    // Continuous parameters stepped at odd positions so no slicing lines up by accident
+    Timeline automation { "automation", "Continuous parameters stepped every ~0.37 s", {} };
+    automation.events.push_back({ 0, [](ParameterDriver& p) { holdExemptFeaturesOff(p); } });
+    int step = 0;
+    for (int64_t pos = static_cast<int64_t>(0.37 * sr) + 17; pos < length; pos += static_cast<int64_t>(0.37 * sr) + 17, ++step)
+    {
+        const float v = (step & 1) ? 0.8f : 0.2f;
+        automation.events.push_back({ pos, [v](ParameterDriver& p)
+        {
+            p.setNormalised("reverbDecay", v);
+            p.setNormalised("delayTime", 1.0f - v);
+            p.setNormalised("reverbMix", v);
+            p.setNormalised("delayMix", 1.0f - v);
+            p.setNormalised("reverbModDepth", v);
+            p.setNormalised("preDelay", v * 0.5f);
+            p.setNormalised("diffusion", v);
+            p.setNormalised("brightness", 1.0f - v);
+            p.setNormalised("masterMix", 0.5f + 0.5f * v);
+        } });
+    }
+    timelines.push_back(std::move(automation));
+
+    // Discrete switches and the block-level paths behind them
+    Timeline features { "features", "Sympathetic strings with pitch follow, shimmer, saturation, 4x degrade; "
+                                    "freeze (loop / spectral), engine, vanish and degrade-threshold switches", {} };
+    features.events.push_back({ 0, [](ParameterDriver& p)
+    {
+        holdExemptFeaturesOff(p);
+        p.setNormalised("sympathetic", 0.6f);
+        p.setNormalised("pitchFollow", 1.0f);
+        p.setNormalised("shimmer", 0.4f);
+        p.setNormalised("tapeSaturation", 1.0f);
+        p.setNormalised("degradeOversampling", 1.0f);
+        p.setPlain("preDelay", 40.0f);
+    } });
+    step = 0;
+    for (int64_t pos = static_cast<int64_t>(0.5 * sr) + 5; pos < length; pos += static_cast<int64_t>(0.5 * sr) + 5, ++step)
+    {
+        features.events.push_back({ pos, [step](ParameterDriver& p)
+        {
+            p.setNormalised("freeze", (step % 4 == 1 || step % 4 == 2) ? 1.0f : 0.0f);
+            p.setNormalised("freezeMode", (step / 4) & 1 ? 1.0f : 0.0f);
+            p.setNormalised("reverbEngine", (step / 3) & 1 ? 1.0f : 0.0f);
+            p.setPlain("degradeAmount", (step & 1) ? 0.02f : 0.0f);
+            p.setPlain("vanishRate", (step & 2) ? 0.8f : 0.0f);
+        } });
+    }
+    timelines.push_back(std::move(features));
+
+    return timelines;
+}
+
+//==============================================================================
+struct Slicing
+{
+    std::string name;
+    int fixedSize;                 // 0: variable
+};
+
+class Slicer
+{
+public:
+    explicit Slicer(int fixed) : fixedSize(fixed) {}
+
+    // Variable sizes from 1 to MAX_BLOCK, odd sizes included
+    int next()
+    {
+        if (fixedSize > 0)
+            return fixedSize;
+        state = state * 1664525u + 1013904223u;
+        const uint32_t r = state >> 8;
+        return (r & 3) == 0 ? 1 + static_cast<int>(r % 7) : 1 + static_cast<int>(r % MAX_BLOCK);
+    }
+
+    static constexpr int MAX_BLOCK = 1024;
+
+private:
+    int fixedSize;
+    uint32_t state = 0x2545F491u;
+};
+
+struct Rendering
+{
+    std::vector<float> left, right;
+};
+
+Rendering render(const Timeline& timeline, const std::vector<float>& inL, const std::vector<float>& inR,
+                 double sr, int fixedSize, bool splitAtEvents)
+{
+    const int64_t length = static_cast<int64_t>(inL.size());
+    auto processor = std::make_unique<AbyssVerbVNAudioProcessor>();
+    ParameterDriver params(*processor);
+    params.resetToDefaults();
+
+    processor->setPlayConfigDetails(2, 2, sr, Slicer::MAX_BLOCK);
+    processor->prepareToPlay(sr, Slicer::MAX_BLOCK);
+
+    Rendering out { std::vector<float>(inL.size()), std::vector<float>(inR.size()) };
+    juce::AudioBuffer<float> buffer(2, Slicer::MAX_BLOCK);
+    juce::MidiBuffer midi;
+    Slicer slicer(fixedSize);
+    size_t nextEvent = 0;
+
+    for (int64_t pos = 0; pos < length;)
+    {
+        // Everything due by this block start takes effect now
+        while (nextEvent < timeline.events.size() && timeline.events[nextEvent].position <= pos)
+            timeline.events[nextEvent++].apply(params);
+
+        int64_t n = juce::jmin<int64_t>(slicer.next(), length - pos);
+        if (splitAtEvents && nextEvent < timeline.events.size())
+            n = juce::jmin<int64_t>(n, timeline.events[nextEvent].position - pos);
+
+        const int numSamples = static_cast<int>(n);
+        buffer.setSize(2, numSamples, false, false, true);
+        buffer.copyFrom(0, 0, inL.data() + pos, numSamples);
+        buffer.copyFrom(1, 0, inR.data() + pos, numSamples);
+        processor->processBlock(buffer, midi);
+        std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + numSamples, out.left.begin() + pos);
+        std::copy(buffer.getReadPointer(1), buffer.getReadPointer(1) + numSamples, out.right.begin() + pos);
+
+        pos += n;
+    }
+
+    processor->releaseResources();
+    return out;
+}
+
+struct Difference
+{
+    double maxAbs = 0.0;
+    int64_t firstIndex = -1;       // First sample over tolerance
+    double rmsErrorDb = -200.0;    // Relative to the reference RMS
+};
+
+Difference compare(const Rendering& test, const Rendering& reference, double tolerance)
+{
+    Difference d;
+    double errorEnergy = 0.0, referenceEnergy = 0.0;
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        const auto& t = ch == 0 ? test.left : test.right;
+        const auto& r = ch == 0 ? reference.left : reference.right;
+        for (size_t i = 0; i < r.size(); ++i)
+        {
+            const double diff = std::abs(static_cast<double>(t[i]) - r[i]);
+            if (! (diff <= tolerance) && (d.firstIndex < 0 || static_cast<int64_t>(i) < d.firstIndex))
+                d.firstIndex = static_cast<int64_t>(i);
+            d.maxAbs = std::isnan(diff) ? diff : juce::jmax(d.maxAbs, diff);
+            errorEnergy += diff * diff;
+            referenceEnergy += static_cast<double>(r[i]) * r[i];
+        }
+    }
+    if (errorEnergy > 0.0)
+        d.rmsErrorDb = juce::jmax(-200.0, 10.0 * std::log10(errorEnergy / juce::jmax(referenceEnergy, 1.0e-30)));
+    return d;
+}
+
+void printUsage()
+{
+    std::cout <<
+        "AbyssBlockInvariance [options]\n"
+        "  --rate r                    sample rate (default 48000)\n"
+        "  --seconds s                 length of each rendering (default 6)\n"
+        "  --tolerance e               max sample difference in split mode (default 1e-6)\n"
+        "  --quantised-tolerance e     also enforce a max difference in quantised mode\n"
+        "  --output file               JSON report (default: stdout)\n";
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    Arguments args(argc, argv);
+    if (args.has("--help"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    const juce::ScopedJuceInitialiser_GUI juceInit;   // APVTS needs a message manager
+
+    const double sr = args.getDouble("--rate", 48000.0);
+    const int64_t length = static_cast<int64_t>(args.getDouble("--seconds", 6.0) * sr);
+    const double tolerance = args.getDouble("--tolerance", 1.0e-6);
+    const double quantisedTolerance = args.getDouble("--quantised-tolerance", -1.0);
+
+    // Phrases with rests, so tails, freezes and re-attacks all fall inside the run
+    std::vector<float> inL(static_cast<size_t>(length)), inR(static_cast<size_t>(length));
+    TestSignal(sr).fill(inL.data(), inR.data(), static_cast<int>(length));
+    for (int64_t i = 0; i < length; ++i)
+    {
+        if (std::fmod(static_cast<double>(i) / sr, 2.0) >= 1.4)
+            inL[static_cast<size_t>(i)] = inR[static_cast<size_t>(i)] = 0.0f;
+    }
+
+    const std::vector<Slicing> slicings { { "32", 32 }, { "512", 512 }, { "variable", 0 } };
+    int failures = 0;
+
+    const bool written = writeReport(args.get("--output"), [&](JsonWriter& json)
+    {
+        json.beginObject();
+        json.field("test", "AbyssBlockInvariance");
+        json.key("config").beginObject()
+            .field("sampleRate", sr)
+            .field("samples", static_cast<int64_t>(length))
+            .field("tolerance", tolerance)
+            .field("reference", "1-sample blocks")
+            .endObject();
+
+        json.key("timelines").beginArray();
+        for (const auto& timeline : createTimelines(sr, length))
+        {
+            const Rendering reference = render(timeline, inL, inR, sr, 1, true);
+
+            json.beginObject()
+                .field("name", timeline.name)
+                .field("description", timeline.description)
+                .field("events", static_cast<int64_t>(timeline.events.size()));
+
+            json.key("results").beginArray();
+            for (bool split : { true, false })
+            {
+                for (const auto& slicing : slicings)
+                {
+                    const double limit = split ? tolerance : quantisedTolerance;
+                    const Difference d = compare(render(timeline, inL, inR, sr, slicing.fixedSize, split),
+                                                 reference, limit >= 0.0 ? limit : 1.0e30);
+                    const bool enforced = limit >= 0.0;
+                    const bool pass = ! enforced || d.maxAbs <= limit;
+                    if (! pass)
+                        ++failures;
+
+                    json.beginObject()
+                        .field("slicing", slicing.name)
+                        .field("mode", split ? "split" : "quantised")
+                        .field("maxAbsDifference", d.maxAbs)
+                        .field("rmsErrorDb", d.rmsErrorDb)
+                        .field("status", enforced ? (pass ? "pass" : "fail") : "report");
+                    json.key("firstSampleOverTolerance");
+                    if (enforced && d.firstIndex >= 0) json.value(d.firstIndex);
+                    else                               json.null();
+                    json.endObject();
+
+                    std::cerr << (enforced ? (pass ? "pass    " : "FAIL    ") : "report  ")
+                              << timeline.name << ", " << slicing.name << " blocks, "
+                              << (split ? "split" : "quantised") << ": max diff " << d.maxAbs
+                              << ", rms " << d.rmsErrorDb << " dB\n";
+                }
+            }
+            json.endArray();
+            json.endObject();
+        }
+        json.endArray();
+
+        json.field("failures", failures);
+        json.endObject();
+    });
+
+    return (written && failures == 0) ? 0 : 1;
+}
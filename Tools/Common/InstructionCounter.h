@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__linux__)
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+ #include <cstring>
+#endif
+
+namespace AbyssTools
+{
+
+//==============================================================================
+// InstructionCounter: retired user-space instructions of the calling thread
+// Linux perf_event only. Unavailable elsewhere, or when the kernel refuses
+// (perf_event_paranoid, containers): callers then report null.
+//==============================================================================
+class InstructionCounter
+{
+public:
+    InstructionCounter()
+    {
+       #if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+       #endif
+    }
+
+    ~InstructionCounter()
+    {
+       #if defined(__linux__)
+        if (fd >= 0)
+            close(fd);
+       #endif
+    }
+
+    InstructionCounter(const InstructionCounter&) = delete;
+    InstructionCounter& operator=(const InstructionCounter&) = delete;
+
+    bool isAvailable() const { return fd >= 0; }
+
+    void start()
+    {
+       #if defined(__linux__)
+        if (fd >= 0)
+        {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+       #endif
+    }
+
+    // Instructions since start(), 0 when unavailable
+    uint64_t stop()
+    {
+        uint64_t count = 0;
+       #if defined(__linux__)
+        if (fd >= 0)
+        {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count)))
+                count = 0;
+        }
+       #endif
+        return count;
+    }
+
+private:
+    int fd = -1;
+};
+
+} // namespace AbyssTools
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <vector>
+
+namespace AbyssTools
+{
+
+//==============================================================================
+// ParameterDriver: host-style access to every parameter of a processor
+// Values are applied the way JUCE's plug-in wrappers apply host automation,
+// on the calling thread right before a callback: setValue() followed by the
+// listener notification that the APVTS raw values are updated from.
+//==============================================================================
+class ParameterDriver
+{
+public:
+    explicit ParameterDriver(juce::AudioProcessor& processor)
+    {
+        for (auto* p : processor.getParameters())
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(p))
+                parameters.push_back(ranged);
+    }
+
+    const std::vector<juce::RangedAudioParameter*>& all() const { return parameters; }
+
+    static void set(juce::RangedAudioParameter& p, float normalised)
+    {
+        p.setValue(normalised);
+        p.sendValueChangedMessageToListeners(normalised);
+    }
+
+    void setNormalised(const juce::String& id, float value)
+    {
+        if (auto* p = find(id))
+            set(*p, juce::jlimit(0.0f, 1.0f, value));
+    }
+
+    // Plain (unnormalised) value, e.g. seconds or feedback gain
+    void setPlain(const juce::String& id, float value)
+    {
+        if (auto* p = find(id))
+            set(*p, p->convertTo0to1(value));
+    }
+
+    void resetToDefaults()
+    {
+        for (auto* p : parameters)
+            set(*p, p->getDefaultValue());
+    }
+
+private:
+    juce::RangedAudioParameter* find(const juce::String& id) const
+    {
+        for (auto* p : parameters)
+            if (p->getParameterID() == id)
+                return p;
+        return nullptr;
+    }
+
+    std::vector<juce::RangedAudioParameter*> parameters;
+};
+
+} // namespace AbyssTools
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//==============================================================================
+// Shared plumbing for the command-line tools under Tools/: argument parsing,
+// a streaming JSON writer, the deterministic test signal and percentiles.
+// Standard library only, so every tool builds with or without the plugin.
+//==============================================================================
+namespace AbyssTools
+{
+
+//==============================================================================
+// Arguments: "--name value" and "--flag" options
+//==============================================================================
+class Arguments
+{
+public:
+    Arguments(int argc, char** argv) : args(argv + 1, argv + argc) {}
+
+    bool has(const std::string& name) const
+    {
+        return std::find(args.begin(), args.end(), name) != args.end();
+    }
+
+    std::string get(const std::string& name, const std::string& fallback = {}) const
+    {
+        for (size_t i = 0; i + 1 < args.size(); ++i)
+            if (args[i] == name)
+                return args[i + 1];
+        return fallback;
+    }
+
+    double getDouble(const std::string& name, double fallback) const
+    {
+        const std::string value = get(name);
+        return value.empty() ? fallback : std::atof(value.c_str());
+    }
+
+    // Comma-separated numbers, e.g. "--rates 44100,48000"
+    std::vector<double> getList(const std::string& name, std::vector<double> fallback) const
+    {
+        const std::string value = get(name);
+        if (value.empty())
+            return fallback;
+
+        std::vector<double> result;
+        std::stringstream stream(value);
+        for (std::string item; std::getline(stream, item, ',');)
+            if (! item.empty())
+                result.push_back(std::atof(item.c_str()));
+        return result;
+    }
+
+    std::vector<std::string> getNames(const std::string& name, std::vector<std::string> fallback) const
+    {
+        const std::string value = get(name);
+        if (value.empty())
+            return fallback;
+
+        std::vector<std::string> result;
+        std::stringstream stream(value);
+        for (std::string item; std::getline(stream, item, ',');)
+            if (! item.empty())
+                result.push_back(item);
+        return result;
+    }
+
+private:
+    std::vector<std::string> args;
+};
+
+//==============================================================================
+// JsonWriter: pretty-printed, streaming, no DOM
+//==============================================================================
+class JsonWriter
+{
+public:
+    explicit JsonWriter(std::ostream& output) : out(output) {}
+
+    JsonWriter& beginObject() { open('{'); return *this; }
+    JsonWriter& endObject()   { close('}'); return *this; }
+    JsonWriter& beginArray()  { open('['); return *this; }
+    JsonWriter& endArray()    { close(']'); return *this; }
+
+    JsonWriter& key(const std::string& name)
+    {
+        separate();
+        writeString(name);
+        out << ": ";
+        pendingKey = true;
+        return *this;
+    }
+
+    JsonWriter& value(double v)
+    {
+        separate();
+        if (std::isfinite(v))
+        {
+            std::ostringstream s;
+            s.precision(9);
+            s << v;
+            out << s.str();
+        }
+        else
+        {
+            out << "null";   // JSON has no Inf/NaN
+        }
+        return *this;
+    }
+
+    JsonWriter& value(int v)                  { separate(); out << v; return *this; }
+    JsonWriter& value(int64_t v)              { separate(); out << v; return *this; }
+    JsonWriter& value(bool v)                 { separate(); out << (v ? "true" : "false"); return *this; }
+    JsonWriter& value(const char* v)          { separate(); writeString(v); return *this; }
+    JsonWriter& value(const std::string& v)   { separate(); writeString(v); return *this; }
+    JsonWriter& null()                        { separate(); out << "null"; return *this; }
+
+    template <typename T>
+    JsonWriter& field(const std::string& name, const T& v) { key(name); return value(v); }
+
+private:
+    void open(char bracket)
+    {
+        separate();
+        out << bracket;
+        firstInScope.push_back(true);
+    }
+
+    void close(char bracket)
+    {
+        const bool empty = firstInScope.back();
+        firstInScope.pop_back();
+        if (! empty)
+            newline();
+        out << bracket;
+        if (firstInScope.empty())
+            out << '\n';
+    }
+
+    // Comma / newline / indent before a new element (not after a key)
+    void separate()
+    {
+        if (pendingKey)
+        {
+            pendingKey = false;
+            return;
+        }
+        if (firstInScope.empty())
+            return;
+
+        if (! firstInScope.back())
+            out << ',';
+        firstInScope.back() = false;
+        newline();
+    }
+
+    void newline()
+    {
+        out << '\n';
+        for (size_t i = 0; i < firstInScope.size(); ++i)
+            out << "  ";
+    }
+
+    void writeString(const std::string& s)
+    {
+        out << '"';
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if (c == '\n')        out << "\\n";
+            else                       out << c;
+        }
+        out << '"';
+    }
+
+    std::ostream& out;
+    std::vector<bool> firstInScope;
+    bool pendingKey = false;
+};
+
+// Write to the file named by --output, or stdout
+template <typename Writer>
+bool writeReport(const std::string& path, Writer&& write)
+{
+    if (path.empty() || path == "-")
+    {
+        JsonWriter json(std::cout);
+        write(json);
+        return true;
+    }
+
+    std::ofstream file(path);
+    if (! file)
+    {
+        std::cerr << "Cannot open " << path << " for writing\n";
+        return false;
+    }
+    JsonWriter json(file);
+    write(json);
+    return static_cast<bool>(file);
+}
+
+//==============================================================================
+// TestSignal: deterministic violin-like stereo input
+// Band-limited-ish sawtooth with vibrato and bow-pressure swells plus a
+// little bow noise; stable across platforms (own LCG, no std::rand).
+//==============================================================================
+class TestSignal
+{
+public:
+    explicit TestSignal(double sampleRate, float frequency = 440.0f, uint32_t seed = 1)
+        : sr(sampleRate), baseFreq(frequency), noiseState(seed | 1u) {}
+
+    void next(float& left, float& right)
+    {
+        const double t = static_cast<double>(sampleIndex++) / sr;
+        const double vibrato = 1.0 + 0.006 * std::sin(2.0 * 3.141592653589793 * 5.5 * t);
+        phase += baseFreq * vibrato / sr;
+        phase -= std::floor(phase);
+
+        const float saw = static_cast<float>(2.0 * phase - 1.0);
+        const float swell = static_cast<float>(0.6 + 0.4 * std::sin(2.0 * 3.141592653589793 * 0.7 * t));
+        const float noise = nextNoise();
+
+        bowLP += 0.3f * (saw - bowLP);
+        left = 0.3f * swell * bowLP + 0.01f * noise;
+        right = 0.28f * swell * bowLP + 0.01f * nextNoise();
+    }
+
+    void fill(float* left, float* right, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            next(left[i], right[i]);
+    }
+
+private:
+    float nextNoise()
+    {
+        noiseState = noiseState * 1664525u + 1013904223u;
+        return static_cast<float>(noiseState >> 8) * (2.0f / 16777216.0f) - 1.0f;
+    }
+
+    double sr;
+    float baseFreq;
+    double phase = 0.0;
+    int64_t sampleIndex = 0;
+    float bowLP = 0.0f;
+    uint32_t noiseState;
+};
+
+//==============================================================================
+// Percentile of an unsorted sample set (nearest rank); sorts a copy
+//==============================================================================
+inline double percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+        return 0.0;
+
+    std::sort(values.begin(), values.end());
+    const double rank = std::ceil(p / 100.0 * static_cast<double>(values.size()));
+    const size_t index = static_cast<size_t>(std::max(1.0, rank)) - 1;
+    return values[std::min(index, values.size() - 1)];
+}
+
+} // namespace AbyssTools
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace AbyssTools
+{
+
+//==============================================================================
+// WavFile: 32-bit float WAV read/write, bit-exact round trip
+// Reference renders must survive storage unchanged, so no format conversion,
+// dither or resampling; the reader only accepts what the writer produces
+// (IEEE float, any channel count), skipping unknown chunks.
+//==============================================================================
+struct WavFile
+{
+    double sampleRate = 48000.0;
+    std::vector<std::vector<float>> channels;
+
+    int getNumChannels() const { return static_cast<int>(channels.size()); }
+    int getNumSamples() const { return channels.empty() ? 0 : static_cast<int>(channels[0].size()); }
+
+    bool write(const std::string& path) const
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (! out)
+            return false;
+
+        const uint16_t numChannels = static_cast<uint16_t>(channels.size());
+        const uint32_t numFrames = static_cast<uint32_t>(getNumSamples());
+        const uint32_t dataBytes = numFrames * numChannels * 4u;
+
+        out.write("RIFF", 4);
+        put32(out, 36u + dataBytes);
+        out.write("WAVE", 4);
+        out.write("fmt ", 4);
+        put32(out, 16u);
+        put16(out, 3u);                                   // WAVE_FORMAT_IEEE_FLOAT
+        put16(out, numChannels);
+        put32(out, static_cast<uint32_t>(sampleRate));
+        put32(out, static_cast<uint32_t>(sampleRate) * numChannels * 4u);
+        put16(out, static_cast<uint16_t>(numChannels * 4u));
+        put16(out, 32u);
+        out.write("data", 4);
+        put32(out, dataBytes);
+
+        std::vector<float> frame(numChannels);
+        for (uint32_t i = 0; i < numFrames; ++i)
+        {
+            for (uint16_t c = 0; c < numChannels; ++c)
+                frame[c] = channels[c][i];
+            out.write(reinterpret_cast<const char*>(frame.data()), static_cast<std::streamsize>(numChannels * 4u));
+        }
+        return static_cast<bool>(out);
+    }
+
+    bool read(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        char tag[4];
+        if (! in.read(tag, 4) || std::memcmp(tag, "RIFF", 4) != 0)
+            return false;
+        get32(in);
+        if (! in.read(tag, 4) || std::memcmp(tag, "WAVE", 4) != 0)
+            return false;
+
+        uint16_t format = 0, numChannels = 0, bits = 0;
+        while (in.read(tag, 4))
+        {
+            const uint32_t size = get32(in);
+            if (std::memcmp(tag, "fmt ", 4) == 0)
+            {
+                format = get16(in);
+                numChannels = get16(in);
+                sampleRate = static_cast<double>(get32(in));
+                get32(in);
+                get16(in);
+                bits = get16(in);
+                in.seekg(static_cast<std::streamoff>(size - 16u + (size & 1u)), std::ios::cur);
+            }
+            else if (std::memcmp(tag, "data", 4) == 0)
+            {
+                if (format != 3 || bits != 32 || numChannels == 0)
+                    return false;
+
+                const uint32_t numFrames = size / (numChannels * 4u);
+                channels.assign(numChannels, std::vector<float>(numFrames));
+                std::vector<float> frame(numChannels);
+                for (uint32_t i = 0; i < numFrames; ++i)
+                {
+                    if (! in.read(reinterpret_cast<char*>(frame.data()), static_cast<std::streamsize>(numChannels * 4u)))
+                        return false;
+                    for (uint16_t c = 0; c < numChannels; ++c)
+                        channels[c][i] = frame[c];
+                }
+                return true;
+            }
+            else
+            {
+                in.seekg(static_cast<std::streamoff>(size + (size & 1u)), std::ios::cur);
+            }
+        }
+        return false;
+    }
+
+private:
+    // Header fields are written byte by byte; sample data goes out in host
+    // order, which is little-endian on every platform the plugin targets
+    static void put16(std::ofstream& out, uint32_t v)
+    {
+        const char b[2] = { static_cast<char>(v & 0xff), static_cast<char>((v >> 8) & 0xff) };
+        out.write(b, 2);
+    }
+
+    static void put32(std::ofstream& out, uint32_t v)
+    {
+        put16(out, v & 0xffff);
+        put16(out, v >> 16);
+    }
+
+    static uint16_t get16(std::ifstream& in)
+    {
+        unsigned char b[2] = {};
+        in.read(reinterpret_cast<char*>(b), 2);
+        return static_cast<uint16_t>(b[0] | (b[1] << 8));
+    }
+
+    static uint32_t get32(std::ifstream& in)
+    {
+        const uint32_t lo = get16(in);
+        return lo | (static_cast<uint32_t>(get16(in)) << 16);
+    }
+};
+
+} // namespace AbyssTools
@@ -0,0 +1,600 @@
+//==============================================================================
+// AbyssDenormalFuzz: denormal / NaN / Inf robustness harness for processBlock
+//
+// Built with ABYSS_CALLER_FPU_MODE, so processBlock keeps the caller's FPU
+// mode instead of setting its own ScopedNoDenormals. Every scenario is
+// rendered twice on fresh processors, with identical input and automation:
+//
+//   ftz     flush-to-zero and denormals-are-zero on (what processBlock sets)
+//   no-ftz  both off, as on a host thread that never set them
+//
+// Per pass it checks the output for NaN / Inf and subnormals, and every few
+// blocks walks all module state (AbyssVerbVNAudioProcessor::probeState) for
+// subnormal and non-finite values. Timing cliffs are found by comparing the
+// two passes block window by block window: same work, so any large ratio is
+// the FPU mode.
+//
+// Failures: non-finite output or state from finite input. With --strict
+// also timing cliffs, subnormal state, and state that stays poisoned after
+// non-finite input.
+//==============================================================================
+
+#include "PluginProcessor.h"
+#include "../Common/ParameterDriver.h"
+#include "../Common/ToolSupport.h"
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+
+#if ! ABYSS_CALLER_FPU_MODE
+ #error "AbyssDenormalFuzz needs ABYSS_CALLER_FPU_MODE: processBlock would force FTZ on itself"
+#endif
+
+using namespace AbyssTools;
+
+namespace
+{
+
+//==============================================================================
+// Bit tests: with DAZ set, comparisons (and so std::fpclassify) read subnormals as zero
+bool isSubnormal(float x)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x7F800000u) == 0 && (bits & 0x007FFFFFu) != 0;
+}
+
+bool isNonFinite(float x)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x7F800000u) == 0x7F800000u;
+}
+
+bool isSubnormal(double x)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x7FF0000000000000ull) == 0 && (bits & 0x000FFFFFFFFFFFFFull) != 0;
+}
+
+bool isNonFinite(double x)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x7FF0000000000000ull) == 0x7FF0000000000000ull;
+}
+
+class ScopedFpuMode
+{
+public:
+    explicit ScopedFpuMode(bool flushDenormals)
+        : previous(juce::FloatVectorOperations::getFpStatusRegister())
+    {
+        juce::FloatVectorOperations::disableDenormalisedNumberSupport(flushDenormals);
+    }
+
+    ~ScopedFpuMode() { juce::FloatVectorOperations::setFpStatusRegister(previous); }
+
+private:
+    intptr_t previous;
+};
+
+//==============================================================================
+// Collects, per module field, the worst subnormal / non-finite counts seen
+class StateScanner : public StateProbe
+{
+public:
+    struct Finding
+    {
+        int64_t firstBlock = -1;
+        size_t maxSubnormal = 0, maxNonFinite = 0;
+    };
+
+    void beginScan(int64_t block) { currentBlock = block; }
+
+    void beginModule(const char* name) override { module = name; }
+
+    void visit(const char* field, const float* values, size_t count) override { scan(field, values, count); }
+    void visit(const char* field, const double* values, size_t count) override { scan(field, values, count); }
+
+    // "module.field" -> finding
+    std::map<std::string, Finding> findings;
+
+private:
+    template <typename T>
+    void scan(const char* field, const T* values, size_t count)
+    {
+        size_t subnormal = 0, nonFinite = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            subnormal += isSubnormal(values[i]) ? 1 : 0;
+            nonFinite += isNonFinite(values[i]) ? 1 : 0;
+        }
+        if (subnormal == 0 && nonFinite == 0)
+            return;
+
+        auto& f = findings[std::string(module) + "." + field];
+        if (f.firstBlock < 0)
+            f.firstBlock = currentBlock;
+        f.maxSubnormal = juce::jmax(f.maxSubnormal, subnormal);
+        f.maxNonFinite = juce::jmax(f.maxNonFinite, nonFinite);
+    }
+
+    const char* module = "";
+    int64_t currentBlock = 0;
+};
+
+//==============================================================================
+struct Scenario
+{
+    std::string name, description;
+    bool finiteInput = true;
+    std::function<void(ParameterDriver&)> setup;
+    // Before every block: block index, block start time in seconds
+    std::function<void(ParameterDriver&, int64_t, double)> automate;
+    // Input for one block: left, right, numSamples, block start time in seconds
+    std::function<void(float*, float*, int, double)> input;
+};
+
+// Worker-thread features would make the two passes' timing incomparable
+void holdWorkersOff(ParameterDriver& params)
+{
+    params.setNormalised("convTail", 0.0f);
+    params.setNormalised("feedbackSuppress", 0.0f);
+}
+
+// Violin-like signal until 'until' seconds, digital silence after
+std::function<void(float*, float*, int, double)> burstThenSilence(double sr, double until)
+{
+    auto signal = std::make_shared<TestSignal>(sr);
+    return [signal, sr, until](float* l, float* r, int n, double t)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            if (t + i / sr < until) signal->next(l[i], r[i]);
+            else                    l[i] = r[i] = 0.0f;
+        }
+    };
+}
+
+std::vector<Scenario> createScenarios(double sr, uint32_t seed)
+{
+    std::vector<Scenario> scenarios;
+
+    // Short RT60s get from full scale to the subnormal range (~-760 dB) within a run
+    scenarios.push_back({ "fdn-decay-to-silence", "1 s of violin, then silence; 0.5 s decay, sympathetic strings, delay",
+        true,
+        [](ParameterDriver& p)
+        {
+            p.setPlain("reverbDecay", 0.5f);
+            p.setPlain("reverbModDepth", 0.0f);
+            p.setPlain("delayFeedback", 0.3f);
+            p.setNormalised("sympathetic", 1.0f);
+        },
+        {}, burstThenSilence(sr, 1.0) });
+
+    scenarios.push_back({ "plate-decay-to-silence", "As fdn-decay-to-silence on the plate engine, with shimmer",
+        true,
+        [](ParameterDriver& p)
+        {
+            p.setNormalised("reverbEngine", 1.0f);
+            p.setPlain("reverbDecay", 0.5f);
+            p.setPlain("delayFeedback", 0.3f);
+            p.setNormalised("shimmer", 0.5f);
+        },
+        {}, burstThenSilence(sr, 1.0) });
+
+    scenarios.push_back({ "subnormal-input", "Random-sign subnormal samples throughout",
+        true, [](ParameterDriver&) {}, {},
+        [state = seed | 1u](float* l, float* r, int n, double) mutable
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                state = state * 1664525u + 1013904223u;
+                const float magnitude = static_cast<float>(state >> 9) * 1.0e-45f;   // Up to ~1.2e-38
+                l[i] = (state & 1) ? magnitude : -magnitude;
+                r[i] = (state & 2) ? magnitude : -magnitude;
+            }
+        } });
+
+    scenarios.push_back({ "near-underflow", "1e-30 sine: normal input whose products underflow",
+        true, [](ParameterDriver&) {}, {},
+        [sr](float* l, float* r, int n, double t)
+        {
+            for (int i = 0; i < n; ++i)
+                l[i] = r[i] = 1.0e-30f * static_cast<float>(std::sin(2.0 * juce::MathConstants<double>::pi * 440.0 * (t + i / sr)));
+        } });
+
+    scenarios.push_back({ "impulses", "Full-scale impulses once a second into silence, 1 s decay",
+        true, [](ParameterDriver& p) { p.setPlain("reverbDecay", 1.0f); }, {},
+        [sr](float* l, float* r, int n, double t)
+        {
+            const int64_t start = static_cast<int64_t>(std::llround(t * sr));
+            const int64_t period = static_cast<int64_t>(sr);
+            for (int i = 0; i < n; ++i)
+                l[i] = r[i] = ((start + i) % period == 0) ? 1.0f : 0.0f;
+        } });
+
+    scenarios.push_back({ "extreme-levels", "+24 dBFS Nyquist, then full-scale DC, then silence; saturation, 0.95 feedback, full degrade",
+        true,
+        [](ParameterDriver& p)
+        {
+            p.setNormalised("tapeSaturation", 1.0f);
+            p.setPlain("delayFeedback", 0.95f);
+            p.setNormalised("degradeAmount", 1.0f);
+            p.setNormalised("degradeOversampling", 1.0f);
+        },
+        {},
+        [sr](float* l, float* r, int n, double t)
+        {
+            const int64_t start = static_cast<int64_t>(std::llround(t * sr));
+            for (int i = 0; i < n; ++i)
+            {
+                const double time = t + i / sr;
+                const float v = time < 0.5 ? (((start + i) & 1) ? 16.0f : -16.0f)
+                              : time < 1.0 ? 1.0f
+                                           : 0.0f;
+                l[i] = r[i] = v;
+            }
+        } });
+
+    auto rng = std::make_shared<std::mt19937>(seed);
+    scenarios.push_back({ "random-automation", "Every parameter jumps every block; 0.3 s violin bursts each second",
+        true, [](ParameterDriver&) {},
+        [rng](ParameterDriver& p, int64_t, double)
+        {
+            std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+            for (auto* param : p.all())
+                ParameterDriver::set(*param, dist(*rng));
+            holdWorkersOff(p);
+        },
+        [signal = std::make_shared<TestSignal>(sr), sr](float* l, float* r, int n, double t)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                signal->next(l[i], r[i]);
+                if (std::fmod(t + i / sr, 1.0) >= 0.3)
+                    l[i] = r[i] = 0.0f;
+            }
+        } });
+
+    scenarios.push_back({ "nonfinite-input", "Violin with a NaN at 1.0 s and +Inf at 1.5 s, silence from 2 s",
+        false,
+        [](ParameterDriver& p) { p.setPlain("reverbDecay", 0.5f); },
+        {},
+        [signal = std::make_shared<TestSignal>(sr), sr](float* l, float* r, int n, double t)
+        {
+            const int64_t start = static_cast<int64_t>(std::llround(t * sr));
+            for (int i = 0; i < n; ++i)
+            {
+                signal->next(l[i], r[i]);
+                const int64_t s = start + i;
+                if (s >= static_cast<int64_t>(2.0 * sr))            l[i] = r[i] = 0.0f;
+                else if (s == static_cast<int64_t>(1.0 * sr))       l[i] = std::numeric_limits<float>::quiet_NaN();
+                else if (s == static_cast<int64_t>(1.5 * sr))       r[i] = std::numeric_limits<float>::infinity();
+            }
+        } });
+
+    return scenarios;
+}
+
+//==============================================================================
+struct PassResult
+{
+    std::vector<double> micros;
+    int64_t firstNonFiniteSample = -1;
+    int64_t nonFiniteSamples = 0, subnormalSamples = 0;
+    bool finiteAtEnd = true;        // Last 0.5 s of output free of NaN / Inf
+    std::map<std::string, StateScanner::Finding> state;
+};
+
+PassResult runPass(const Scenario& scenario, bool flushDenormals, double sr, int blockSize,
+                   int64_t numBlocks, int probeInterval)
+{
+    PassResult result;
+    result.micros.reserve(static_cast<size_t>(numBlocks));
+
+    auto processor = std::make_unique<AbyssVerbVNAudioProcessor>();
+    ParameterDriver params(*processor);
+    params.resetToDefaults();
+    holdWorkersOff(params);
+    scenario.setup(params);
+
+    processor->setPlayConfigDetails(2, 2, sr, blockSize);
+    processor->prepareToPlay(sr, blockSize);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    StateScanner scanner;
+    const int64_t tailStart = numBlocks * blockSize - static_cast<int64_t>(0.5 * sr);
+
+    for (int64_t block = 0; block < numBlocks; ++block)
+    {
+        const int64_t start = block * blockSize;
+        const double t = static_cast<double>(start) / sr;
+        if (scenario.automate)
+            scenario.automate(params, block, t);
+        scenario.input(buffer.getWritePointer(0), buffer.getWritePointer(1), blockSize, t);
+
+        std::chrono::steady_clock::time_point begin, end;
+        {
+            const ScopedFpuMode mode(flushDenormals);
+            begin = std::chrono::steady_clock::now();
+            processor->processBlock(buffer, midi);
+            end = std::chrono::steady_clock::now();
+        }
+        result.micros.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            const float* out = buffer.getReadPointer(ch);
+            for (int i = 0; i < blockSize; ++i)
+            {
+                if (isNonFinite(out[i]))
+                {
+                    ++result.nonFiniteSamples;
+                    if (result.firstNonFiniteSample < 0 || start + i < result.firstNonFiniteSample)
+                        result.firstNonFiniteSample = start + i;
+                    if (start + i >= tailStart)
+                        result.finiteAtEnd = false;
+                }
+                else if (isSubnormal(out[i]))
+                {
+                    ++result.subnormalSamples;
+                }
+            }
+        }
+
+        if (block % probeInterval == 0 || block == numBlocks - 1)
+        {
+            scanner.beginScan(block);
+            processor->probeState(scanner);
+        }
+    }
+
+    processor->releaseResources();
+    result.state = std::move(scanner.findings);
+    return result;
+}
+
+//==============================================================================
+// Windows where the no-FTZ pass ran cliffFactor times slower than the FTZ pass
+struct CliffReport
+{
+    int windows = 0, cliffs = 0;
+    double worstRatio = 0.0, firstCliffSeconds = -1.0, medianRatio = 0.0;
+};
+
+CliffReport findCliffs(const std::vector<double>& ftz, const std::vector<double>& noFtz, int window,
+                       double cliffFactor, double minMicros, double blockSeconds)
+{
+    CliffReport report;
+    std::vector<double> ratios;
+    const size_t n = juce::jmin(ftz.size(), noFtz.size());
+
+    for (size_t start = 0; start + static_cast<size_t>(window) <= n; start += static_cast<size_t>(window))
+    {
+        // Window medians shrug off single-block scheduling noise
+        const std::vector<double> a(ftz.begin() + static_cast<std::ptrdiff_t>(start), ftz.begin() + static_cast<std::ptrdiff_t>(start) + window);
+        const std::vector<double> b(noFtz.begin() + static_cast<std::ptrdiff_t>(start), noFtz.begin() + static_cast<std::ptrdiff_t>(start) + window);
+        const double ftzMedian = percentile(a, 50.0);
+        const double noFtzMedian = percentile(b, 50.0);
+        const double ratio = noFtzMedian / juce::jmax(ftzMedian, 1.0e-3);
+
+        ratios.push_back(ratio);
+        ++report.windows;
+        report.worstRatio = juce::jmax(report.worstRatio, ratio);
+
+        if (ratio > cliffFactor && noFtzMedian > minMicros)
+        {
+            if (report.cliffs++ == 0)
+                report.firstCliffSeconds = static_cast<double>(start) * blockSeconds;
+        }
+    }
+
+    report.medianRatio = percentile(ratios, 50.0);
+    return report;
+}
+
+void writeState(JsonWriter& json, const std::map<std::string, StateScanner::Finding>& state)
+{
+    json.beginArray();
+    for (const auto& [field, f] : state)
+    {
+        json.beginObject()
+            .field("field", field)
+            .field("firstBlock", f.firstBlock)
+            .field("maxSubnormal", static_cast<int64_t>(f.maxSubnormal))
+            .field("maxNonFinite", static_cast<int64_t>(f.maxNonFinite))
+            .endObject();
+    }
+    json.endArray();
+}
+
+void writePass(JsonWriter& json, const PassResult& pass)
+{
+    double sum = 0.0;
+    for (double m : pass.micros)
+        sum += m;
+
+    json.beginObject()
+        .field("meanUs", pass.micros.empty() ? 0.0 : sum / static_cast<double>(pass.micros.size()))
+        .field("p50Us", percentile(pass.micros, 50.0))
+        .field("p99Us", percentile(pass.micros, 99.0))
+        .field("maxUs", percentile(pass.micros, 100.0))
+        .field("nonFiniteSamples", pass.nonFiniteSamples)
+        .field("firstNonFiniteSample", pass.firstNonFiniteSample)
+        .field("subnormalSamples", pass.subnormalSamples)
+        .field("finiteAtEnd", pass.finiteAtEnd);
+    json.key("state");
+    writeState(json, pass.state);
+    json.endObject();
+}
+
+void printUsage()
+{
+    std::cout <<
+        "AbyssDenormalFuzz [options]\n"
+        "  --rate r             sample rate (default 48000)\n"
+        "  --block n            block size (default 256)\n"
+        "  --seconds s          audio rendered per scenario and pass (default 8)\n"
+        "  --scenarios a,b,..   subset of scenarios (default: all)\n"
+        "  --cliff-factor f     no-FTZ / FTZ window time ratio counted as a cliff (default 4)\n"
+        "  --cliff-min-us us    ignore windows faster than this without FTZ (default 5)\n"
+        "  --window n           blocks per timing window (default 8)\n"
+        "  --probe-interval n   blocks between module state scans (default 8)\n"
+        "  --seed n             seed for random input and automation (default 1)\n"
+        "  --strict             also fail on cliffs, subnormal state and poisoned state\n"
+        "  --output file        JSON report (default: stdout)\n";
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    Arguments args(argc, argv);
+    if (args.has("--help"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    const juce::ScopedJuceInitialiser_GUI juceInit;   // APVTS needs a message manager
+
+    const double sr = args.getDouble("--rate", 48000.0);
+    const int blockSize = juce::jmax(1, static_cast<int>(args.getDouble("--block", 256.0)));
+    const double seconds = args.getDouble("--seconds", 8.0);
+    const double cliffFactor = args.getDouble("--cliff-factor", 4.0);
+    const double cliffMinMicros = args.getDouble("--cliff-min-us", 5.0);
+    const int window = juce::jmax(1, static_cast<int>(args.getDouble("--window", 8.0)));
+    const int probeInterval = juce::jmax(1, static_cast<int>(args.getDouble("--probe-interval", 8.0)));
+    const uint32_t seed = static_cast<uint32_t>(args.getDouble("--seed", 1.0));
+    const bool strict = args.has("--strict");
+    const int64_t numBlocks = juce::jmax<int64_t>(1, static_cast<int64_t>(seconds * sr) / blockSize);
+
+    const auto wanted = args.getNames("--scenarios", {});
+    std::vector<std::string> names;
+    for (const auto& s : createScenarios(sr, seed))
+        if (wanted.empty() || std::find(wanted.begin(), wanted.end(), s.name) != wanted.end())
+            names.push_back(s.name);
+
+    if (names.empty())
+    {
+        std::cerr << "No matching scenarios\n";
+        return 1;
+    }
+
+    // Scenarios carry generator state: each pass gets a fresh, identically seeded set
+    auto scenarioNamed = [&](const std::string& name)
+    {
+        for (auto& s : createScenarios(sr, seed))
+            if (s.name == name)
+                return s;
+        return Scenario {};
+    };
+
+    int failures = 0;
+
+    const bool written = writeReport(args.get("--output"), [&](JsonWriter& json)
+    {
+        json.beginObject();
+        json.field("harness", "AbyssDenormalFuzz");
+        json.key("config").beginObject()
+            .field("sampleRate", sr)
+            .field("blockSize", blockSize)
+            .field("secondsPerPass", seconds)
+            .field("cliffFactor", cliffFactor)
+            .field("cliffMinUs", cliffMinMicros)
+            .field("window", window)
+            .field("probeInterval", probeInterval)
+            .field("seed", static_cast<int64_t>(seed))
+            .field("strict", strict)
+            .endObject();
+
+        json.key("scenarios").beginArray();
+        for (const auto& name : names)
+        {
+            const Scenario scenario = scenarioNamed(name);
+            const PassResult ftz = runPass(scenarioNamed(name), true, sr, blockSize, numBlocks, probeInterval);
+            const PassResult noFtz = runPass(scenarioNamed(name), false, sr, blockSize, numBlocks, probeInterval);
+            const CliffReport cliffs = findCliffs(ftz.micros, noFtz.micros, window, cliffFactor,
+                                                  cliffMinMicros, blockSize / sr);
+
+            std::vector<std::string> problems;
+            bool failed = false;
+            for (const auto* pass : { &ftz, &noFtz })
+            {
+                const char* mode = pass == &ftz ? "ftz" : "no-ftz";
+                bool stateNonFinite = false, stateSubnormal = false;
+                for (const auto& [field, f] : pass->state)
+                {
+                    stateNonFinite |= f.maxNonFinite > 0;
+                    stateSubnormal |= f.maxSubnormal > 0;
+                }
+
+                if (scenario.finiteInput && (pass->nonFiniteSamples > 0 || stateNonFinite))
+                {
+                    problems.push_back(std::string("non-finite output or state from finite input (") + mode + ")");
+                    failed = true;
+                }
+                if (! scenario.finiteInput && ! pass->finiteAtEnd)
+                {
+                    problems.push_back(std::string("output still non-finite after the input recovered (") + mode + ")");
+                    failed |= strict;
+                }
+                if (stateSubnormal)
+                {
+                    problems.push_back(std::string("subnormal module state (") + mode + ")");
+                    failed |= strict;
+                }
+            }
+            if (cliffs.cliffs > 0)
+            {
+                problems.push_back("timing cliff without FTZ");
+                failed |= strict;
+            }
+            if (failed)
+                ++failures;
+
+            std::cerr << (failed ? "FAIL  " : problems.empty() ? "pass  " : "flag  ") << name
+                      << ": no-FTZ / FTZ median " << cliffs.medianRatio << "x, worst " << cliffs.worstRatio
+                      << "x, " << cliffs.cliffs << " cliff windows\n";
+            for (const auto& p : problems)
+                std::cerr << "      " << p << "\n";
+
+            json.beginObject()
+                .field("name", scenario.name)
+                .field("description", scenario.description)
+                .field("finiteInput", scenario.finiteInput)
+                .field("status", failed ? "fail" : problems.empty() ? "pass" : "flagged");
+            json.key("problems").beginArray();
+            for (const auto& p : problems)
+                json.value(p);
+            json.endArray();
+            json.key("timing").beginObject()
+                .field("windows", cliffs.windows)
+                .field("cliffWindows", cliffs.cliffs)
+                .field("medianRatio", cliffs.medianRatio)
+                .field("worstRatio", cliffs.worstRatio)
+                .field("firstCliffSeconds", cliffs.firstCliffSeconds)
+                .endObject();
+            json.key("ftz");
+            writePass(json, ftz);
+            json.key("noFtz");
+            writePass(json, noFtz);
+            json.endObject();
+        }
+        json.endArray();
+
+        json.field("failures", failures);
+        json.endObject();
+    });
+
+    return (written && failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,438 @@
+//==============================================================================
+// AbyssGolden: golden-reference renders for AbyssFDNReverb / VanishingDelay
+//
+//   AbyssGolden render  --dir refs      store the current implementation's output
+//   AbyssGolden compare --dir refs      re-render and diff against the store
+//
+// A fixed corpus (impulse, log sweep, noise burst, violin-like phrase) runs
+// through a set of module presets. compare reports max-abs error, RMS error
+// relative to the reference, and the worst third-octave band deviation of
+// the long-term spectrum, and fails cases beyond the given tolerances.
+// References are toolchain-specific where VanishingDelay's vanish is active:
+// std::uniform_*_distribution output differs between standard libraries.
+//==============================================================================
+
+#include "AbyssDSP.h"
+#include "../Common/ToolSupport.h"
+#include "../Common/WavFile.h"
+
+#include <functional>
+#include <memory>
+
+using namespace AbyssTools;
+
+namespace
+{
+
+constexpr int CORPUS_VERSION = 1;
+
+//==============================================================================
+// Corpus signals: excitation in the first second, silence after
+//==============================================================================
+struct Signal
+{
+    std::string name;
+    std::function<void(double sr, std::vector<float>& left, std::vector<float>& right)> generate;
+};
+
+std::vector<Signal> createSignals()
+{
+    std::vector<Signal> signals;
+
+    signals.push_back({ "impulse", [](double, std::vector<float>& l, std::vector<float>& r)
+    {
+        l[0] = r[0] = 1.0f;
+    } });
+
+    signals.push_back({ "sweep", [](double sr, std::vector<float>& l, std::vector<float>& r)
+    {
+        // Exponential sine sweep 20 Hz -> 20 kHz over one second, -12 dBFS
+        const double f0 = 20.0, f1 = juce::jmin(20000.0, 0.45 * sr), duration = 1.0;
+        const double k = std::log(f1 / f0);
+        const int length = juce::jmin(static_cast<int>(l.size()), static_cast<int>(sr * duration));
+        for (int i = 0; i < length; ++i)
+        {
+            const double t = static_cast<double>(i) / sr;
+            const double phase = 2.0 * juce::MathConstants<double>::pi * f0 * duration / k * (std::exp(t / duration * k) - 1.0);
+            l[static_cast<size_t>(i)] = r[static_cast<size_t>(i)] = static_cast<float>(0.25 * std::sin(phase));
+        }
+    } });
+
+    signals.push_back({ "noise", [](double sr, std::vector<float>& l, std::vector<float>& r)
+    {
+        uint32_t state = 0x12345678u;
+        auto next = [&state]
+        {
+            state = state * 1664525u + 1013904223u;
+            return static_cast<float>(state >> 8) * (2.0f / 16777216.0f) - 1.0f;
+        };
+        const int length = juce::jmin(static_cast<int>(l.size()), static_cast<int>(sr * 0.5));
+        for (int i = 0; i < length; ++i)
+        {
+            l[static_cast<size_t>(i)] = 0.25f * next();
+            r[static_cast<size_t>(i)] = 0.25f * next();
+        }
+    } });
+
+    signals.push_back({ "violin", [](double sr, std::vector<float>& l, std::vector<float>& r)
+    {
+        TestSignal source(sr);
+        const int length = juce::jmin(static_cast<int>(l.size()), static_cast<int>(sr));
+        source.fill(l.data(), r.data(), length);
+    } });
+
+    return signals;
+}
+
+//==============================================================================
+// Module presets: stereo pair as wired in the processor
+//==============================================================================
+struct Preset
+{
+    std::string name, description;
+    std::function<void(double sr, const std::vector<float>& inL, const std::vector<float>& inR,
+                       std::vector<float>& outL, std::vector<float>& outR)> render;
+};
+
+struct FDNSettings
+{
+    float decay, dampHigh, dampLow, modDepth, modRate, detune;
+    bool saturate = false;
+    float shimmer = 0.0f;
+};
+
+Preset fdnPreset(const std::string& name, const std::string& description, FDNSettings s)
+{
+    return { name, description, [s](double sr, const std::vector<float>& inL, const std::vector<float>& inR,
+                                     std::vector<float>& outL, std::vector<float>& outR)
+    {
+        auto left = std::make_unique<AbyssFDNReverb>();
+        auto right = std::make_unique<AbyssFDNReverb>();
+        for (auto* fdn : { left.get(), right.get() })
+        {
+            fdn->prepare(sr, 512);
+            fdn->clear();
+            fdn->setSaturation(s.saturate);
+        }
+
+        for (size_t i = 0; i < inL.size(); ++i)
+        {
+            for (auto* fdn : { left.get(), right.get() })
+            {
+                fdn->setParameters(s.decay, s.dampHigh, s.dampLow, s.modDepth, s.modRate, s.detune);
+                fdn->setShimmer(s.shimmer, 2.0f);
+            }
+            outL[i] = left->process(inL[i]);
+            outR[i] = right->process(inR[i]);
+        }
+    } };
+}
+
+struct DelaySettings
+{
+    float timeMs, feedback, vanishRate, degrade, drift;
+    bool saturate = false;
+    int oversampling = 1;
+};
+
+Preset delayPreset(const std::string& name, const std::string& description, DelaySettings s)
+{
+    return { name, description, [s](double sr, const std::vector<float>& inL, const std::vector<float>& inR,
+                                     std::vector<float>& outL, std::vector<float>& outR)
+    {
+        auto left = std::make_unique<VanishingDelay>();
+        auto right = std::make_unique<VanishingDelay>();
+        for (auto* delay : { left.get(), right.get() })
+        {
+            delay->prepare(sr, 512);
+            delay->clear();
+            delay->setSaturation(s.saturate);
+            delay->setDegradeOversampling(s.oversampling);
+        }
+
+        for (size_t i = 0; i < inL.size(); ++i)
+        {
+            left->setParameters(s.timeMs, s.feedback, s.vanishRate, s.degrade, s.drift);
+            right->setParameters(s.timeMs * 1.07f, s.feedback, s.vanishRate, s.degrade, s.drift * 1.15f);
+            outL[i] = left->process(inL[i]);
+            outR[i] = right->process(inR[i]);
+        }
+    } };
+}
+
+std::vector<Preset> createPresets()
+{
+    return {
+        fdnPreset("fdn-default", "Parameter defaults",
+                  { 6.0f, 0.7f, 0.3f, 0.5f, 0.3f, 0.0f }),
+        fdnPreset("fdn-long", "30 s decay, light damping, no modulation",
+                  { 30.0f, 0.2f, 0.1f, 0.0f, 0.3f, 0.0f }),
+        fdnPreset("fdn-dark", "Short, heavily damped, deep fast modulation, full detune",
+                  { 3.0f, 0.95f, 0.8f, 3.0f, 2.0f, 1.0f }),
+        fdnPreset("fdn-saturated", "Defaults with tape saturation in the loop",
+                  { 6.0f, 0.7f, 0.3f, 0.5f, 0.3f, 0.0f, true }),
+        fdnPreset("fdn-shimmer", "Defaults with octave shimmer at 0.5",
+                  { 6.0f, 0.7f, 0.3f, 0.5f, 0.3f, 0.0f, false, 0.5f }),
+        delayPreset("delay-default", "Parameter defaults",
+                    { 400.0f, 0.5f, 0.3f, 0.3f, 2.0f }),
+        delayPreset("delay-clean", "No vanish, degrade just below its threshold, no drift",
+                    { 400.0f, 0.5f, 0.0f, 0.005f, 0.0f }),
+        delayPreset("delay-extreme", "1.5 s, 0.95 feedback, max vanish / degrade / drift, saturated",
+                    { 1500.0f, 0.95f, 0.8f, 1.0f, 10.0f, true }),
+        delayPreset("delay-oversampled", "Heavy degrade through the 4x oversampler",
+                    { 400.0f, 0.5f, 0.3f, 0.8f, 2.0f, false, 4 }),
+    };
+}
+
+//==============================================================================
+// Error metrics
+//==============================================================================
+struct ChannelError
+{
+    double maxAbs = 0.0;
+    double rmsErrorDb = -200.0;     // Relative to the reference RMS
+    double maxBandErrorDb = 0.0;    // Worst third-octave band, long-term spectrum
+};
+
+// Long-term third-octave band powers (Hann, 50% overlap)
+std::vector<double> bandPowers(const std::vector<float>& x, double sr)
+{
+    constexpr int order = 12, size = 1 << order;
+    juce::dsp::FFT fft(order);
+    std::vector<float> window(size), frame(2 * size);
+    for (int i = 0; i < size; ++i)
+        window[static_cast<size_t>(i)] = 0.5f - 0.5f * std::cos(2.0f * juce::MathConstants<float>::pi * static_cast<float>(i) / size);
+
+    std::vector<double> power(size / 2 + 1, 0.0);
+    for (size_t start = 0; start + size <= x.size(); start += size / 2)
+    {
+        std::fill(frame.begin(), frame.end(), 0.0f);
+        for (int i = 0; i < size; ++i)
+            frame[static_cast<size_t>(i)] = x[start + static_cast<size_t>(i)] * window[static_cast<size_t>(i)];
+        fft.performFrequencyOnlyForwardTransform(frame.data(), true);
+        for (size_t k = 0; k < power.size(); ++k)
+            power[k] += static_cast<double>(frame[k]) * frame[k];
+    }
+
+    std::vector<double> bands;
+    const double binHz = sr / size;
+    for (double centre = 20.0; centre * std::pow(2.0, 1.0 / 6.0) < sr * 0.5; centre *= std::pow(2.0, 1.0 / 3.0))
+    {
+        const int lo = static_cast<int>(std::ceil(centre * std::pow(2.0, -1.0 / 6.0) / binHz));
+        const int hi = static_cast<int>(std::floor(centre * std::pow(2.0, 1.0 / 6.0) / binHz));
+        double sum = 0.0;
+        for (int k = juce::jmax(1, lo); k <= hi && k < static_cast<int>(power.size()); ++k)
+            sum += power[static_cast<size_t>(k)];
+        bands.push_back(sum);
+    }
+    return bands;
+}
+
+ChannelError compareChannel(const std::vector<float>& test, const std::vector<float>& reference, double sr)
+{
+    ChannelError e;
+    double errorEnergy = 0.0, referenceEnergy = 0.0;
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        const double d = static_cast<double>(test[i]) - reference[i];
+        e.maxAbs = juce::jmax(e.maxAbs, std::abs(d));
+        errorEnergy += d * d;
+        referenceEnergy += static_cast<double>(reference[i]) * reference[i];
+    }
+    if (errorEnergy > 0.0)
+        e.rmsErrorDb = juce::jmax(-200.0, 10.0 * std::log10(errorEnergy / juce::jmax(referenceEnergy, 1.0e-30)));
+
+    // Bands within 60 dB of the loudest one; quieter ones are numerical noise
+    const auto testBands = bandPowers(test, sr);
+    const auto refBands = bandPowers(reference, sr);
+    const double loudest = refBands.empty() ? 0.0 : *std::max_element(refBands.begin(), refBands.end());
+    for (size_t b = 0; b < refBands.size(); ++b)
+        if (refBands[b] > loudest * 1.0e-6 && refBands[b] > 0.0)
+            e.maxBandErrorDb = juce::jmax(e.maxBandErrorDb,
+                                          std::abs(10.0 * std::log10(juce::jmax(testBands[b], 1.0e-30) / refBands[b])));
+    return e;
+}
+
+//==============================================================================
+struct Case
+{
+    const Preset* preset;
+    const Signal* signal;
+    std::string name() const { return preset->name + "_" + signal->name; }
+};
+
+WavFile renderCase(const Case& c, double sr, int length)
+{
+    std::vector<float> inL(static_cast<size_t>(length), 0.0f), inR(static_cast<size_t>(length), 0.0f);
+    c.signal->generate(sr, inL, inR);
+
+    WavFile wav;
+    wav.sampleRate = sr;
+    wav.channels.assign(2, std::vector<float>(static_cast<size_t>(length), 0.0f));
+    c.preset->render(sr, inL, inR, wav.channels[0], wav.channels[1]);
+    return wav;
+}
+
+void printUsage()
+{
+    std::cout <<
+        "AbyssGolden render|compare|list --dir DIR [options]\n"
+        "  --rate r                  sample rate (default 48000)\n"
+        "  --seconds s               render length per case (default 2)\n"
+        "  --cases a,b,..            substrings selecting cases (default: all)\n"
+        "compare options:\n"
+        "  --max-rms-error-db d      RMS error relative to the reference (default -80)\n"
+        "  --max-band-error-db d     worst third-octave band deviation (default 0.1)\n"
+        "  --max-abs-error e         peak sample error (default: not checked)\n"
+        "  --output file             JSON report (default: stdout)\n";
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    Arguments args(argc, argv);
+    const std::string mode = argc > 1 ? argv[1] : "";
+    const std::string dir = args.get("--dir");
+    if (args.has("--help") || (mode != "render" && mode != "compare" && mode != "list")
+        || (mode != "list" && dir.empty()))
+    {
+        printUsage();
+        return mode.empty() || args.has("--help") ? 0 : 1;
+    }
+
+    const double sr = args.getDouble("--rate", 48000.0);
+    const int length = static_cast<int>(args.getDouble("--seconds", 2.0) * sr);
+    const auto filters = args.getNames("--cases", {});
+
+    const auto signals = createSignals();
+    const auto presets = createPresets();
+    std::vector<Case> cases;
+    for (const auto& preset : presets)
+    {
+        for (const auto& signal : signals)
+        {
+            Case c { &preset, &signal };
+            bool selected = filters.empty();
+            for (const auto& f : filters)
+                selected = selected || c.name().find(f) != std::string::npos;
+            if (selected)
+                cases.push_back(c);
+        }
+    }
+
+    if (mode == "list")
+    {
+        for (const auto& c : cases)
+            std::cout << c.name() << "  (" << c.preset->description << ")\n";
+        return 0;
+    }
+
+    const juce::ScopedNoDenormals noDenormals;   // As in processBlock
+
+    if (mode == "render")
+    {
+        for (const auto& c : cases)
+        {
+            if (! renderCase(c, sr, length).write(dir + "/" + c.name() + ".wav"))
+            {
+                std::cerr << "Cannot write " << dir << "/" << c.name() << ".wav\n";
+                return 1;
+            }
+            std::cerr << "rendered " << c.name() << "\n";
+        }
+
+        std::ofstream manifestFile(dir + "/manifest.json");
+        JsonWriter json(manifestFile);
+        json.beginObject()
+            .field("corpusVersion", CORPUS_VERSION)
+            .field("sampleRate", sr)
+            .field("samples", length);
+        json.key("cases").beginArray();
+        for (const auto& c : cases)
+            json.beginObject()
+                .field("name", c.name())
+                .field("preset", c.preset->name)
+                .field("description", c.preset->description)
+                .field("signal", c.signal->name)
+                .endObject();
+        json.endArray();
+        json.endObject();
+        return manifestFile ? 0 : 1;
+    }
+
+    // compare
+    const double maxRmsErrorDb = args.getDouble("--max-rms-error-db", -80.0);
+    const double maxBandErrorDb = args.getDouble("--max-band-error-db", 0.1);
+    const double maxAbsError = args.getDouble("--max-abs-error", -1.0);
+
+    int failures = 0;
+    const bool written = writeReport(args.get("--output"), [&](JsonWriter& json)
+    {
+        json.beginObject();
+        json.field("tool", "AbyssGolden");
+        json.key("tolerances").beginObject()
+            .field("maxRmsErrorDb", maxRmsErrorDb)
+            .field("maxBandErrorDb", maxBandErrorDb);
+        json.key("maxAbsError");
+        if (maxAbsError >= 0.0) json.value(maxAbsError);
+        else                    json.null();
+        json.endObject();
+
+        json.key("cases").beginArray();
+        for (const auto& c : cases)
+        {
+            json.beginObject().field("name", c.name());
+
+            WavFile reference;
+            if (! reference.read(dir + "/" + c.name() + ".wav"))
+            {
+                json.field("status", "missing").endObject();
+                std::cerr << "MISSING " << c.name() << "\n";
+                ++failures;
+                continue;
+            }
+
+            const int refLength = reference.getNumSamples();
+            if (reference.getNumChannels() != 2 || reference.sampleRate != sr || refLength < 1)
+            {
+                json.field("status", "format mismatch").endObject();
+                std::cerr << "FORMAT  " << c.name() << "\n";
+                ++failures;
+                continue;
+            }
+
+            const WavFile test = renderCase(c, sr, refLength);
+            ChannelError worst;
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                const auto e = compareChannel(test.channels[static_cast<size_t>(ch)],
+                                              reference.channels[static_cast<size_t>(ch)], sr);
+                worst.maxAbs = juce::jmax(worst.maxAbs, e.maxAbs);
+                worst.rmsErrorDb = juce::jmax(worst.rmsErrorDb, e.rmsErrorDb);
+                worst.maxBandErrorDb = juce::jmax(worst.maxBandErrorDb, e.maxBandErrorDb);
+            }
+
+            const bool pass = worst.rmsErrorDb <= maxRmsErrorDb
+                           && worst.maxBandErrorDb <= maxBandErrorDb
+                           && (maxAbsError < 0.0 || worst.maxAbs <= maxAbsError);
+            if (! pass)
+                ++failures;
+
+            json.field("status", pass ? "pass" : "fail")
+                .field("maxAbsError", worst.maxAbs)
+                .field("rmsErrorDb", worst.rmsErrorDb)
+                .field("maxBandErrorDb", worst.maxBandErrorDb)
+                .endObject();
+
+            std::cerr << (pass ? "pass    " : "FAIL    ") << c.name() << ": rms " << worst.rmsErrorDb
+                      << " dB, band " << worst.maxBandErrorDb << " dB, peak " << worst.maxAbs << "\n";
+        }
+        json.endArray();
+        json.field("failures", failures);
+        json.endObject();
+    });
+
+    return (written && failures == 0) ? 0 : 1;
+}
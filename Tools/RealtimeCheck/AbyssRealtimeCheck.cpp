@@ -0,0 +1,348 @@
+//==============================================================================
+// AbyssRealtimeCheck: real-time safety test for the audio thread
+//
+// Built with ABYSS_RT_CHECK, so processBlock and the state-reset part of
+// prepareToPlay run inside real-time sections, and with RealtimeHooks, which
+// catch every allocation, blocking lock, file access or sleep made inside
+// one. Each run re-prepares the same processor instance and drives it with:
+//
+//   automation  random parameter values, with all-minimum / all-maximum
+//               jumps, before blocks of random size up to the prepared maximum
+//   presets     preset loads (setStateInformation -> replaceState, pickup IR
+//               restore and removal) on the message thread while an audio
+//               thread renders
+//   conv tail   static settings with Mod Depth 0 and Conv Tail on, long
+//               enough for a capture to be built and swapped in; the run
+//               fails if the convolution tail never went active, since
+//               that path would otherwise go unchecked
+//
+// The hooks are proven live first: probes inside a section must be caught,
+// or the run fails instead of passing vacuously.
+//==============================================================================
+
+#include "PluginProcessor.h"
+#include "RealtimeHooks.h"
+#include "../Common/ParameterDriver.h"
+#include "../Common/ToolSupport.h"
+#include "../Common/WavFile.h"
+
+#include <atomic>
+#include <functional>
+#include <random>
+#include <thread>
+
+using namespace AbyssTools;
+
+namespace
+{
+
+//==============================================================================
+struct Probe
+{
+    const char* name;
+    bool needsLibraryHooks;
+    void (*run)();
+};
+
+const Probe probes[] =
+{
+    { "operator new", false, [] { ::operator delete(::operator new(64)); } },
+    { "malloc", true, [] { void* volatile block = std::malloc(64); std::free(block); } },
+    { "mutex", true, [] { juce::CriticalSection lock; const juce::ScopedLock scope(lock); } },
+    { "file I/O", true, [] { if (auto* file = std::fopen("/dev/null", "r")) std::fclose(file); } },
+};
+
+bool probeCaught(const Probe& probe)
+{
+    const int64_t before = AbyssRT::Hooks::getNumViolations();
+    {
+        ABYSS_REALTIME_SECTION("self-test");
+        probe.run();
+    }
+    return AbyssRT::Hooks::getNumViolations() > before;
+}
+
+//==============================================================================
+// Short decaying-noise body response, so presets can carry a pickup IR
+bool writePickupIR(const juce::File& file)
+{
+    WavFile wav;
+    wav.sampleRate = 48000.0;
+    wav.channels.assign(1, std::vector<float>(2048));
+    uint32_t state = 12345u;
+    for (size_t i = 0; i < wav.channels[0].size(); ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        const float noise = static_cast<float>(state >> 8) * (2.0f / 16777216.0f) - 1.0f;
+        wav.channels[0][i] = noise * std::exp(-static_cast<float>(i) / 300.0f);
+    }
+    return wav.write(file.getFullPathName().toStdString());
+}
+
+std::vector<juce::MemoryBlock> createPresets(AbyssVerbVNAudioProcessor& processor, int count,
+                                             uint32_t seed, const juce::File& pickupIR)
+{
+    ParameterDriver params(processor);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    std::vector<juce::MemoryBlock> presets;
+    for (int i = 0; i < count; ++i)
+    {
+        for (auto* p : params.all())
+            ParameterDriver::set(*p, dist(rng));
+
+        // Every other preset carries the pickup IR: loads alternate between swapping it in and out
+        processor.apvts.state.setProperty("pickupIR", (i & 1) ? pickupIR.getFullPathName() : juce::String(), nullptr);
+
+        juce::MemoryBlock state;
+        processor.getStateInformation(state);
+        presets.push_back(std::move(state));
+    }
+
+    params.resetToDefaults();
+    processor.clearPickupIR();
+    return presets;
+}
+
+//==============================================================================
+// Renders numSamples in blocks of random size; automate runs before each block
+void render(AbyssVerbVNAudioProcessor& processor, juce::AudioBuffer<float>& buffer, int maxBlockSize,
+            double sr, int64_t numSamples, uint32_t seed, const std::function<void(int64_t)>& automate)
+{
+    juce::MidiBuffer midi;
+    TestSignal signal(sr);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> blockSize(1, maxBlockSize);
+
+    for (int64_t done = 0, block = 0; done < numSamples; ++block)
+    {
+        const int n = static_cast<int>(juce::jmin<int64_t>(blockSize(rng), numSamples - done));
+        if (automate)
+            automate(block);
+
+        buffer.setSize(2, n, false, false, true);
+        signal.fill(buffer.getWritePointer(0), buffer.getWritePointer(1), n);
+        processor.processBlock(buffer, midi);
+        done += n;
+    }
+}
+
+struct RunResult
+{
+    double sampleRate;
+    int maxBlockSize;
+    int64_t presetLoads;
+    bool convTailEngaged;
+    std::vector<AbyssRT::Hooks::Violation> violations;
+};
+
+// Long enough for the capture to go live at every rate with the 1 s decay used
+constexpr double MIN_CONV_TAIL_SECONDS = 6.0;
+
+RunResult runChecks(AbyssVerbVNAudioProcessor& processor, const std::vector<juce::MemoryBlock>& presets,
+                    double sr, int maxBlockSize, double seconds, uint32_t seed)
+{
+    RunResult result { sr, maxBlockSize, 0, false, {} };
+    const int64_t numSamples = static_cast<int64_t>(seconds * sr);
+
+    processor.releaseResources();
+    processor.setPlayConfigDetails(2, 2, sr, maxBlockSize);
+    processor.prepareToPlay(sr, maxBlockSize);
+
+    juce::AudioBuffer<float> buffer(2, maxBlockSize);
+
+    // Automation: the host applies it on the audio thread, between callbacks
+    ParameterDriver params(processor);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> value(0.0f, 1.0f);
+    std::uniform_int_distribution<size_t> which(0, params.all().size() - 1);
+
+    render(processor, buffer, maxBlockSize, sr, numSamples, seed, [&](int64_t block)
+    {
+        if (block % 16 == 0)
+        {
+            const float extreme = (block / 16) & 1 ? 1.0f : 0.0f;
+            for (auto* p : params.all())
+                ParameterDriver::set(*p, extreme);
+        }
+        else
+        {
+            for (int i = 0; i < 4; ++i)
+                ParameterDriver::set(*params.all()[which(rng)], value(rng));
+        }
+    });
+
+    // Presets: loaded on the message thread while the audio thread keeps going
+    std::atomic<bool> rendering { true };
+    std::thread audioThread([&]
+    {
+        render(processor, buffer, maxBlockSize, sr, numSamples, seed + 1, {});
+        rendering.store(false);
+    });
+
+    while (rendering.load())
+    {
+        const auto& preset = presets[static_cast<size_t>(result.presetLoads++) % presets.size()];
+        processor.setStateInformation(preset.getData(), static_cast<int>(preset.getSize()));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    audioThread.join();
+
+    // Convolution tail: settings held still, so the worker captures the FDN and
+    // the hybrid crosses over to it (250 ms settle + capture + ~1.4 s flush)
+    params.resetToDefaults();
+    params.setPlain("reverbModDepth", 0.0f);
+    params.setPlain("reverbDecay", 1.0f);
+    params.setNormalised("convTail", 1.0f);
+
+    // Until it engages, rendering is paced so the low-priority capture worker
+    // keeps up with audio time even on a loaded machine
+    const double tailSeconds = juce::jmax(seconds, MIN_CONV_TAIL_SECONDS);
+    const auto pace = std::chrono::microseconds(static_cast<int64_t>(maxBlockSize * 1.0e6 / (4.0 * sr)));
+    render(processor, buffer, maxBlockSize, sr, static_cast<int64_t>(tailSeconds * sr), seed + 2, [&](int64_t)
+    {
+        result.convTailEngaged = result.convTailEngaged || processor.isConvolutionTailActive();
+        if (! result.convTailEngaged)
+            std::this_thread::sleep_for(pace);
+    });
+    params.resetToDefaults();
+
+    result.violations = AbyssRT::Hooks::takeViolations();
+    return result;
+}
+
+void printUsage()
+{
+    std::cout <<
+        "AbyssRealtimeCheck [options]\n"
+        "  --rates r1,r2,..    sample rates (default 44100,48000,96000)\n"
+        "  --blocks b1,b2,..   maximum block sizes (default 64,512)\n"
+        "  --seconds s         audio rendered per phase and run (default 4; conv tail phase at least 6)\n"
+        "  --presets n         distinct presets cycled through (default 8)\n"
+        "  --seed n            seed for parameter values and block sizes (default 1)\n"
+        "  --abort             abort with a stack trace at the first violation\n"
+        "  --output file       JSON report (default: stdout)\n";
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    Arguments args(argc, argv);
+    if (args.has("--help"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    const juce::ScopedJuceInitialiser_GUI juceInit;   // APVTS needs a message manager
+
+    const auto rates = args.getList("--rates", { 44100.0, 48000.0, 96000.0 });
+    const auto blocks = args.getList("--blocks", { 64.0, 512.0 });
+    const double seconds = args.getDouble("--seconds", 4.0);
+    const int numPresets = juce::jmax(1, static_cast<int>(args.getDouble("--presets", 8.0)));
+    const uint32_t seed = static_cast<uint32_t>(args.getDouble("--seed", 1.0));
+
+    int failures = 0;
+
+    std::vector<std::pair<const char*, bool>> selfTest;
+    for (const auto& probe : probes)
+    {
+        if (probe.needsLibraryHooks && ! AbyssRT::Hooks::hasLibraryHooks())
+            continue;
+        const bool caught = probeCaught(probe);
+        selfTest.emplace_back(probe.name, caught);
+        if (! caught)
+        {
+            std::cerr << "Hook inactive: " << probe.name << " inside a real-time section went unnoticed\n";
+            ++failures;
+        }
+    }
+    AbyssRT::Hooks::takeViolations();
+
+    const auto pickupIR = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                              .getNonexistentChildFile("AbyssRealtimeCheckIR", ".wav");
+    if (! writePickupIR(pickupIR))
+    {
+        std::cerr << "Cannot write " << pickupIR.getFullPathName().toStdString() << "\n";
+        return 1;
+    }
+
+    AbyssVerbVNAudioProcessor processor;
+    const auto presets = createPresets(processor, numPresets, seed, pickupIR);
+
+    AbyssRT::Hooks::setAbortOnViolation(args.has("--abort"));
+
+    std::vector<RunResult> runs;
+    for (double sr : rates)
+    {
+        for (double block : blocks)
+        {
+            runs.push_back(runChecks(processor, presets, sr, static_cast<int>(block), seconds, seed));
+            const auto& run = runs.back();
+
+            int64_t count = 0;
+            for (const auto& v : run.violations)
+                count += v.count;
+            failures += static_cast<int>(run.violations.size()) + (run.convTailEngaged ? 0 : 1);
+
+            const bool passed = run.violations.empty() && run.convTailEngaged;
+            std::cerr << (passed ? "pass  " : "FAIL  ") << sr << " Hz, blocks up to "
+                      << run.maxBlockSize << ": " << run.presetLoads << " preset loads, "
+                      << count << " violations"
+                      << (run.convTailEngaged ? "" : ", convolution tail never went active") << "\n";
+            for (const auto& v : run.violations)
+                std::cerr << "      " << v.call << " inside " << v.section << " (" << v.count << "x)\n";
+        }
+    }
+
+    processor.releaseResources();
+    pickupIR.deleteFile();
+
+    const bool written = writeReport(args.get("--output"), [&](JsonWriter& json)
+    {
+        json.beginObject();
+        json.field("test", "AbyssRealtimeCheck");
+        json.field("libraryHooks", AbyssRT::Hooks::hasLibraryHooks());
+
+        json.key("selfTest").beginObject();
+        for (const auto& [name, caught] : selfTest)
+            json.field(name, caught);
+        json.endObject();
+
+        json.key("runs").beginArray();
+        for (const auto& run : runs)
+        {
+            json.beginObject()
+                .field("sampleRate", run.sampleRate)
+                .field("maxBlockSize", run.maxBlockSize)
+                .field("secondsPerPhase", seconds)
+                .field("presetLoads", run.presetLoads)
+                .field("convTailEngaged", run.convTailEngaged);
+
+            json.key("violations").beginArray();
+            for (const auto& v : run.violations)
+            {
+                json.beginObject()
+                    .field("call", v.call)
+                    .field("section", v.section)
+                    .field("count", v.count);
+                json.key("stack").beginArray();
+                for (const auto& frame : v.stack)
+                    json.value(frame);
+                json.endArray();
+                json.endObject();
+            }
+            json.endArray();
+            json.endObject();
+        }
+        json.endArray();
+
+        json.field("failures", failures);
+        json.endObject();
+    });
+
+    return (written && failures == 0) ? 0 : 1;
+}
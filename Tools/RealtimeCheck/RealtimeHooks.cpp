@@ -0,0 +1,457 @@
+// Replaces C library functions: the fortified inline wrappers must not exist here
+#undef _FORTIFY_SOURCE
+
+#include "RealtimeHooks.h"
+#include "RealtimeCheck.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if ! ABYSS_RT_CHECK
+ #error "RealtimeHooks.cpp belongs in ABYSS_RT_CHECK builds only"
+#endif
+
+#if defined(__GLIBC__)
+ #define ABYSS_RT_LIBRARY_HOOKS 1
+ #include <dlfcn.h>
+ #include <errno.h>
+ #include <fcntl.h>
+ #include <pthread.h>
+ #include <stdarg.h>
+ #include <stdio.h>
+ #include <sys/syscall.h>
+ #include <time.h>
+ #include <unistd.h>
+#else
+ #define ABYSS_RT_LIBRARY_HOOKS 0
+#endif
+
+#if __has_include(<execinfo.h>)
+ #include <execinfo.h>
+ #define ABYSS_RT_BACKTRACE 1
+#else
+ #define ABYSS_RT_BACKTRACE 0
+#endif
+
+#if ABYSS_RT_LIBRARY_HOOKS
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+}
+#endif
+
+namespace
+{
+
+//==============================================================================
+// Allocation underneath the hooks, so operator new is not reported twice
+#if ABYSS_RT_LIBRARY_HOOKS
+void* rawAlloc(size_t size)                     { return __libc_malloc(size); }
+void* rawAlignedAlloc(size_t align, size_t size) { return __libc_memalign(align, size); }
+void rawFree(void* ptr)                         { __libc_free(ptr); }
+#else
+void* rawAlloc(size_t size)                     { return std::malloc(size); }
+void* rawAlignedAlloc(size_t align, size_t size)
+{
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, align < sizeof(void*) ? sizeof(void*) : align, size) == 0 ? ptr : nullptr;
+}
+void rawFree(void* ptr)                         { std::free(ptr); }
+#endif
+
+//==============================================================================
+constexpr int MAX_RECORDS = 64;
+constexpr int MAX_FRAMES = 24;
+
+struct Record
+{
+    const char* call;
+    const char* section;
+    int numFrames;
+    void* frames[MAX_FRAMES];
+    int64_t count;
+};
+
+Record records[MAX_RECORDS];
+int numRecords = 0;
+std::atomic_flag recordLock = ATOMIC_FLAG_INIT;
+std::atomic<int64_t> totalViolations { 0 };
+std::atomic<bool> abortOnViolation { false };
+
+// Set while a hook is reporting: whatever the reporting itself calls passes through
+thread_local bool insideHook = false;
+
+void writeToStderr(const char* text)
+{
+#if ABYSS_RT_LIBRARY_HOOKS
+    // Straight to the kernel: write() is hooked
+    ::syscall(SYS_write, 2, text, std::strlen(text));
+#else
+    std::fputs(text, stderr);
+#endif
+}
+
+int captureStack(void** frames)
+{
+#if ABYSS_RT_BACKTRACE
+    return backtrace(frames, MAX_FRAMES);
+#else
+    (void) frames;
+    return 0;
+#endif
+}
+
+void report(const char* call, const char* section)
+{
+    totalViolations.fetch_add(1, std::memory_order_relaxed);
+
+    void* frames[MAX_FRAMES];
+    const int numFrames = captureStack(frames);
+
+    if (abortOnViolation.load(std::memory_order_relaxed))
+    {
+        writeToStderr("Real-time violation: ");
+        writeToStderr(call);
+        writeToStderr(" inside ");
+        writeToStderr(section);
+        writeToStderr("\n");
+#if ABYSS_RT_BACKTRACE
+        backtrace_symbols_fd(frames, numFrames, 2);
+#endif
+        std::abort();
+    }
+
+    while (recordLock.test_and_set(std::memory_order_acquire)) {}
+
+    Record* match = nullptr;
+    for (int i = 0; i < numRecords && match == nullptr; ++i)
+    {
+        Record& r = records[i];
+        if (r.call == call && r.section == section && r.numFrames == numFrames
+            && std::memcmp(r.frames, frames, sizeof(void*) * static_cast<size_t>(numFrames)) == 0)
+            match = &r;
+    }
+
+    if (match == nullptr && numRecords < MAX_RECORDS)
+    {
+        match = &records[numRecords++];
+        *match = { call, section, numFrames, {}, 0 };
+        std::memcpy(match->frames, frames, sizeof(void*) * static_cast<size_t>(numFrames));
+    }
+
+    if (match != nullptr)
+        ++match->count;
+
+    recordLock.clear(std::memory_order_release);
+}
+
+inline void check(const char* call)
+{
+    const char* section = AbyssRT::currentSection;
+    if (section == nullptr || insideHook)
+        return;
+
+    insideHook = true;
+    report(call, section);
+    insideHook = false;
+}
+
+// backtrace() loads its unwinder on first use, which allocates: get that done up front
+const bool stackCaptureReady = []
+{
+    void* frames[MAX_FRAMES];
+    return captureStack(frames) >= 0;
+}();
+
+} // namespace
+
+//==============================================================================
+namespace AbyssRT::Hooks
+{
+
+bool hasLibraryHooks() { return ABYSS_RT_LIBRARY_HOOKS != 0; }
+
+void setAbortOnViolation(bool shouldAbort) { abortOnViolation.store(shouldAbort); }
+
+int64_t getNumViolations() { return totalViolations.load(); }
+
+std::vector<Violation> takeViolations()
+{
+    std::vector<Violation> result;
+
+    while (recordLock.test_and_set(std::memory_order_acquire)) {}
+
+    for (int i = 0; i < numRecords; ++i)
+    {
+        const Record& r = records[i];
+        Violation v { r.call, r.section, r.count, {} };
+#if ABYSS_RT_BACKTRACE
+        // Frame 0 is report() itself
+        if (char** symbols = backtrace_symbols(r.frames, r.numFrames))
+        {
+            for (int f = 1; f < r.numFrames; ++f)
+                v.stack.emplace_back(symbols[f]);
+            std::free(symbols);
+        }
+#endif
+        result.push_back(std::move(v));
+    }
+    numRecords = 0;
+
+    recordLock.clear(std::memory_order_release);
+    totalViolations.store(0);
+    return result;
+}
+
+} // namespace AbyssRT::Hooks
+
+//==============================================================================
+// operator new / delete (all platforms)
+//==============================================================================
+namespace
+{
+void* checkedNew(size_t size, const char* call)
+{
+    check(call);
+    if (void* ptr = rawAlloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* checkedAlignedNew(size_t size, std::align_val_t align, const char* call)
+{
+    check(call);
+    if (void* ptr = rawAlignedAlloc(static_cast<size_t>(align), size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void checkedDelete(void* ptr, const char* call)
+{
+    if (ptr != nullptr)
+        check(call);
+    rawFree(ptr);
+}
+} // namespace
+
+void* operator new(size_t size)                                              { return checkedNew(size, "operator new"); }
+void* operator new[](size_t size)                                            { return checkedNew(size, "operator new[]"); }
+void* operator new(size_t size, std::align_val_t align)                      { return checkedAlignedNew(size, align, "operator new"); }
+void* operator new[](size_t size, std::align_val_t align)                    { return checkedAlignedNew(size, align, "operator new[]"); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    try { return checkedNew(size, "operator new"); } catch (...) { return nullptr; }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    try { return checkedNew(size, "operator new[]"); } catch (...) { return nullptr; }
+}
+
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+    try { return checkedAlignedNew(size, align, "operator new"); } catch (...) { return nullptr; }
+}
+
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+    try { return checkedAlignedNew(size, align, "operator new[]"); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* ptr) noexcept                                          { checkedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr) noexcept                                        { checkedDelete(ptr, "operator delete[]"); }
+void operator delete(void* ptr, size_t) noexcept                                  { checkedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, size_t) noexcept                                { checkedDelete(ptr, "operator delete[]"); }
+void operator delete(void* ptr, std::align_val_t) noexcept                        { checkedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, std::align_val_t) noexcept                      { checkedDelete(ptr, "operator delete[]"); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept                { checkedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept              { checkedDelete(ptr, "operator delete[]"); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept                   { checkedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept                 { checkedDelete(ptr, "operator delete[]"); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { checkedDelete(ptr, "operator delete"); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { checkedDelete(ptr, "operator delete[]"); }
+
+//==============================================================================
+// C library (glibc): definitions in the executable take precedence over libc's
+//==============================================================================
+#if ABYSS_RT_LIBRARY_HOOKS
+
+namespace
+{
+// The next definitions in lookup order, i.e. libc's. Resolved lazily, since
+// hooks run before static initialisation is done, and without function-local
+// statics, whose guards would take a mutex.
+// Plain pointer types: decltype(&::open) would carry libc's nonnull attributes
+using LockFunction = int (*)(pthread_mutex_t*);
+using RwlockFunction = int (*)(pthread_rwlock_t*);
+using OpenFunction = int (*)(const char*, int, ...);
+using OpenatFunction = int (*)(int, const char*, int, ...);
+using FopenFunction = FILE* (*)(const char*, const char*);
+using ReadFunction = ssize_t (*)(int, void*, size_t);
+using WriteFunction = ssize_t (*)(int, const void*, size_t);
+using CloseFunction = int (*)(int);
+using NanosleepFunction = int (*)(const struct timespec*, struct timespec*);
+using UsleepFunction = int (*)(useconds_t);
+
+std::atomic<LockFunction> nextMutexLock { nullptr };
+std::atomic<RwlockFunction> nextRwlockRdlock { nullptr }, nextRwlockWrlock { nullptr };
+std::atomic<OpenFunction> nextOpen { nullptr };
+std::atomic<OpenatFunction> nextOpenat { nullptr };
+std::atomic<FopenFunction> nextFopen { nullptr };
+std::atomic<ReadFunction> nextRead { nullptr };
+std::atomic<WriteFunction> nextWrite { nullptr };
+std::atomic<CloseFunction> nextClose { nullptr };
+std::atomic<NanosleepFunction> nextNanosleep { nullptr };
+std::atomic<UsleepFunction> nextUsleep { nullptr };
+
+template <typename Function>
+Function next(std::atomic<Function>& slot, const char* name)
+{
+    Function function = slot.load(std::memory_order_acquire);
+    if (function == nullptr)
+    {
+        function = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+        slot.store(function, std::memory_order_release);
+    }
+    return function;
+}
+
+// dlsym() allocates: resolve everything before any real-time section opens
+const bool libraryResolved = []
+{
+    return next(nextMutexLock, "pthread_mutex_lock") != nullptr
+        && next(nextRwlockRdlock, "pthread_rwlock_rdlock") != nullptr
+        && next(nextRwlockWrlock, "pthread_rwlock_wrlock") != nullptr
+        && next(nextOpen, "open") != nullptr
+        && next(nextOpenat, "openat") != nullptr
+        && next(nextFopen, "fopen") != nullptr
+        && next(nextRead, "read") != nullptr
+        && next(nextWrite, "write") != nullptr
+        && next(nextClose, "close") != nullptr
+        && next(nextNanosleep, "nanosleep") != nullptr
+        && next(nextUsleep, "usleep") != nullptr;
+}();
+
+mode_t variadicMode(int flags, va_list args)
+{
+    const bool creates = (flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE;
+    return creates ? static_cast<mode_t>(va_arg(args, unsigned int)) : 0;
+}
+} // namespace
+
+extern "C"
+{
+
+// Allocation
+void* malloc(size_t size)                  { check("malloc"); return __libc_malloc(size); }
+void* calloc(size_t count, size_t size)    { check("calloc"); return __libc_calloc(count, size); }
+void* realloc(void* ptr, size_t size)      { check("realloc"); return __libc_realloc(ptr, size); }
+void* memalign(size_t align, size_t size)  { check("memalign"); return __libc_memalign(align, size); }
+void* aligned_alloc(size_t align, size_t size) { check("aligned_alloc"); return __libc_memalign(align, size); }
+
+void free(void* ptr)
+{
+    if (ptr != nullptr)
+        check("free");
+    __libc_free(ptr);
+}
+
+int posix_memalign(void** result, size_t align, size_t size)
+{
+    check("posix_memalign");
+    if (align < sizeof(void*) || (align & (align - 1)) != 0)
+        return EINVAL;
+    void* ptr = __libc_memalign(align, size);
+    if (ptr == nullptr)
+        return ENOMEM;
+    *result = ptr;
+    return 0;
+}
+
+// Locks (try-locks stay legal: they never block)
+int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+    check("pthread_mutex_lock");
+    return next(nextMutexLock, "pthread_mutex_lock")(mutex);
+}
+
+int pthread_rwlock_rdlock(pthread_rwlock_t* lock)
+{
+    check("pthread_rwlock_rdlock");
+    return next(nextRwlockRdlock, "pthread_rwlock_rdlock")(lock);
+}
+
+int pthread_rwlock_wrlock(pthread_rwlock_t* lock)
+{
+    check("pthread_rwlock_wrlock");
+    return next(nextRwlockWrlock, "pthread_rwlock_wrlock")(lock);
+}
+
+// File I/O
+int open(const char* path, int flags, ...)
+{
+    check("open");
+    va_list args;
+    va_start(args, flags);
+    const mode_t mode = variadicMode(flags, args);
+    va_end(args);
+    return next(nextOpen, "open")(path, flags, mode);
+}
+
+int openat(int dir, const char* path, int flags, ...)
+{
+    check("openat");
+    va_list args;
+    va_start(args, flags);
+    const mode_t mode = variadicMode(flags, args);
+    va_end(args);
+    return next(nextOpenat, "openat")(dir, path, flags, mode);
+}
+
+FILE* fopen(const char* path, const char* mode)
+{
+    check("fopen");
+    return next(nextFopen, "fopen")(path, mode);
+}
+
+ssize_t read(int fd, void* buffer, size_t size)
+{
+    check("read");
+    return next(nextRead, "read")(fd, buffer, size);
+}
+
+ssize_t write(int fd, const void* buffer, size_t size)
+{
+    check("write");
+    return next(nextWrite, "write")(fd, buffer, size);
+}
+
+int close(int fd)
+{
+    check("close");
+    return next(nextClose, "close")(fd);
+}
+
+// Sleeping
+int nanosleep(const struct timespec* duration, struct timespec* remaining)
+{
+    check("nanosleep");
+    return next(nextNanosleep, "nanosleep")(duration, remaining);
+}
+
+int usleep(useconds_t micros)
+{
+    check("usleep");
+    return next(nextUsleep, "usleep")(micros);
+}
+
+} // extern "C"
+
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AbyssRT
+{
+
+//==============================================================================
+// RealtimeHooks: reports calls made inside an ABYSS_REALTIME_SECTION
+// operator new / delete are replaced on every platform. On glibc the C
+// library is interposed as well: malloc family, mutex and rwlock locking,
+// file I/O (open, fopen, read, write, close) and sleeping.
+// Calls are recorded without allocating; identical call sites are merged.
+//==============================================================================
+namespace Hooks
+{
+    struct Violation
+    {
+        std::string call, section;
+        int64_t count = 0;
+        std::vector<std::string> stack;   // Innermost frame first
+    };
+
+    // False where only operator new / delete can be checked
+    bool hasLibraryHooks();
+
+    // Print the stack and abort at the offending call (for a debugger) instead of recording
+    void setAbortOnViolation(bool shouldAbort);
+
+    int64_t getNumViolations();
+
+    // Symbolises and clears the record; call outside real-time sections
+    std::vector<Violation> takeViolations();
+}
+
+} // namespace AbyssRT
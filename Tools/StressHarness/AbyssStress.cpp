@@ -0,0 +1,302 @@
+//==============================================================================
+// AbyssStress: worst-case execution time harness for processBlock
+//
+// Drives AbyssVerbVNAudioProcessor the way a host does (parameter automation
+// on the audio thread, right before each callback) through scenarios built
+// to hit the expensive paths, and times every single block. Reports
+// p50 / p99 / p99.9 / max per scenario and flags each block that overran
+// the budget (by default the block's own real-time duration).
+//==============================================================================
+
+#include "PluginProcessor.h"
+#include "../Common/ParameterDriver.h"
+#include "../Common/ToolSupport.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <random>
+
+using namespace AbyssTools;
+
+namespace
+{
+
+//==============================================================================
+struct Scenario
+{
+    std::string name;
+    std::string description;
+    // Called before every block: block index, block start time in seconds
+    std::function<void(ParameterDriver&, int64_t, double)> automate;
+};
+
+float triangle(double t, double period)
+{
+    const double phase = t / period - std::floor(t / period);
+    return static_cast<float>(phase < 0.5 ? 2.0 * phase : 2.0 - 2.0 * phase);
+}
+
+std::vector<Scenario> createScenarios(uint32_t seed)
+{
+    std::vector<Scenario> scenarios;
+
+    scenarios.push_back({ "sweep", "Every parameter swept 0..1 by its own slow triangle",
+        [](ParameterDriver& params, int64_t, double t)
+        {
+            int i = 0;
+            for (auto* p : params.all())
+                ParameterDriver::set(*p, triangle(t, 3.0 + 0.37 * i++));
+        } });
+
+    auto rng = std::make_shared<std::mt19937>(seed);
+    scenarios.push_back({ "jumps", "Every parameter jumps to a random value every block",
+        [rng](ParameterDriver& params, int64_t, double)
+        {
+            std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+            for (auto* p : params.all())
+                ParameterDriver::set(*p, dist(*rng));
+        } });
+
+    scenarios.push_back({ "extremes", "All parameters alternate between minimum and maximum every second",
+        [](ParameterDriver& params, int64_t, double t)
+        {
+            const float value = (static_cast<int64_t>(t) & 1) ? 1.0f : 0.0f;
+            for (auto* p : params.all())
+                ParameterDriver::set(*p, value);
+        } });
+
+    scenarios.push_back({ "triggers",
+        "30 s decay and 0.95 feedback held; degradeAmount crossing 0.01 every 8 blocks, "
+        "vanishRate flipping 0 / 0.8 every 5 blocks, oversampling / freeze / engine / tail toggles",
+        [](ParameterDriver& params, int64_t block, double t)
+        {
+            params.setPlain("reverbDecay", 30.0f);
+            params.setPlain("delayFeedback", 0.95f);
+            params.setPlain("reverbModDepth", 0.0f);    // Static FDN: lets the convolution tail engage
+            params.setNormalised("convTail", 1.0f);
+            params.setPlain("degradeAmount", ((block / 8) & 1) ? 0.02f : 0.0f);
+            params.setPlain("vanishRate", ((block / 5) & 1) ? 0.8f : 0.0f);
+            params.setNormalised("degradeOversampling", static_cast<float>(static_cast<int64_t>(t / 2.0) % 3) / 2.0f);
+            params.setNormalised("freeze", (static_cast<int64_t>(t / 3.0) & 1) ? 1.0f : 0.0f);
+            params.setNormalised("reverbEngine", (static_cast<int64_t>(t / 4.0) & 1) ? 1.0f : 0.0f);
+        } });
+
+    return scenarios;
+}
+
+//==============================================================================
+struct FlaggedBlock
+{
+    int64_t index;
+    double timeSeconds, micros;
+};
+
+struct ScenarioResult
+{
+    std::string name, description;
+    std::vector<double> micros;
+    std::vector<FlaggedBlock> flagged;
+    int64_t overBudget = 0;
+};
+
+ScenarioResult runScenario(AbyssVerbVNAudioProcessor& processor, const Scenario& scenario,
+                           double sr, int blockSize, double seconds, double budgetMicros, size_t maxFlagged)
+{
+    ScenarioResult result;
+    result.name = scenario.name;
+    result.description = scenario.description;
+
+    ParameterDriver params(processor);
+    params.resetToDefaults();
+    processor.setPlayConfigDetails(2, 2, sr, blockSize);
+    processor.prepareToPlay(sr, blockSize);
+
+    const int64_t numBlocks = static_cast<int64_t>(seconds * sr) / blockSize;
+    result.micros.reserve(static_cast<size_t>(numBlocks));
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    TestSignal signal(sr);
+
+    for (int64_t block = 0; block < numBlocks; ++block)
+    {
+        const double t = static_cast<double>(block * blockSize) / sr;
+        scenario.automate(params, block, t);
+
+        // Input in 2 s phrases separated by 1 s of silence: tails decay, inputs re-excite
+        float* left = buffer.getWritePointer(0);
+        float* right = buffer.getWritePointer(1);
+        signal.fill(left, right, blockSize);
+        if (std::fmod(t, 3.0) >= 2.0)
+        {
+            std::fill(left, left + blockSize, 0.0f);
+            std::fill(right, right + blockSize, 0.0f);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        processor.processBlock(buffer, midi);
+        const auto end = std::chrono::steady_clock::now();
+
+        const double micros = std::chrono::duration<double, std::micro>(end - start).count();
+        result.micros.push_back(micros);
+
+        if (micros > budgetMicros)
+        {
+            ++result.overBudget;
+            if (result.flagged.size() < maxFlagged)
+                result.flagged.push_back({ block, t, micros });
+        }
+    }
+
+    processor.releaseResources();
+    return result;
+}
+
+void printUsage()
+{
+    std::cout <<
+        "AbyssStress [options]\n"
+        "  --rates r1,r2,..     sample rates (default 48000)\n"
+        "  --blocks b1,b2,..    block sizes (default 64,256)\n"
+        "  --seconds s          audio rendered per scenario (default 20)\n"
+        "  --scenarios a,b,..   sweep,jumps,extremes,triggers (default: all)\n"
+        "  --budget-fraction f  budget as a fraction of the block duration (default 1.0)\n"
+        "  --budget-us us       fixed budget in microseconds (overrides the fraction)\n"
+        "  --max-flagged n      over-budget blocks listed per scenario (default 50)\n"
+        "  --seed n             seed for the random-jump scenario (default 1)\n"
+        "  --strict             exit with status 2 if any block overran\n"
+        "  --output file        JSON report (default: stdout)\n";
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    Arguments args(argc, argv);
+    if (args.has("--help"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    const juce::ScopedJuceInitialiser_GUI juceInit;   // APVTS needs a message manager
+
+    const auto rates = args.getList("--rates", { 48000.0 });
+    const auto blocks = args.getList("--blocks", { 64.0, 256.0 });
+    const double seconds = args.getDouble("--seconds", 20.0);
+    const double budgetFraction = args.getDouble("--budget-fraction", 1.0);
+    const double fixedBudget = args.getDouble("--budget-us", 0.0);
+    const size_t maxFlagged = static_cast<size_t>(juce::jmax(0.0, args.getDouble("--max-flagged", 50.0)));
+    const uint32_t seed = static_cast<uint32_t>(args.getDouble("--seed", 1.0));
+
+    std::vector<Scenario> scenarios;
+    const auto wanted = args.getNames("--scenarios", {});
+    for (auto& s : createScenarios(seed))
+        if (wanted.empty() || std::find(wanted.begin(), wanted.end(), s.name) != wanted.end())
+            scenarios.push_back(std::move(s));
+
+    if (scenarios.empty())
+    {
+        std::cerr << "No matching scenarios\n";
+        return 1;
+    }
+
+    struct RunResult
+    {
+        double sampleRate;
+        int blockSize;
+        double budgetMicros;
+        std::vector<ScenarioResult> scenarios;
+    };
+
+    std::vector<RunResult> runs;
+    int64_t totalOverBudget = 0;
+
+    AbyssVerbVNAudioProcessor processor;
+    for (double sr : rates)
+    {
+        for (double block : blocks)
+        {
+            const int blockSize = static_cast<int>(block);
+            const double budget = fixedBudget > 0.0 ? fixedBudget : budgetFraction * 1.0e6 * blockSize / sr;
+            RunResult run { sr, blockSize, budget, {} };
+
+            for (const auto& scenario : scenarios)
+            {
+                run.scenarios.push_back(runScenario(processor, scenario, sr, blockSize, seconds, budget, maxFlagged));
+                const auto& r = run.scenarios.back();
+                totalOverBudget += r.overBudget;
+                std::cerr << scenario.name << " @ " << sr << " Hz, " << blockSize << " samples: p99.9 "
+                          << percentile(r.micros, 99.9) << " us, max " << percentile(r.micros, 100.0)
+                          << " us, budget " << budget << " us, " << r.overBudget << " over\n";
+            }
+
+            runs.push_back(std::move(run));
+        }
+    }
+
+    const bool written = writeReport(args.get("--output"), [&](JsonWriter& json)
+    {
+        json.beginObject();
+        json.field("harness", "AbyssStress");
+        json.key("config").beginObject()
+            .field("secondsPerScenario", seconds)
+            .field("budgetFraction", budgetFraction)
+            .field("fixedBudgetUs", fixedBudget)
+            .field("seed", static_cast<int64_t>(seed))
+            .endObject();
+
+        json.key("runs").beginArray();
+        for (const auto& run : runs)
+        {
+            json.beginObject()
+                .field("sampleRate", run.sampleRate)
+                .field("blockSize", run.blockSize)
+                .field("budgetUs", run.budgetMicros);
+
+            json.key("scenarios").beginArray();
+            for (const auto& s : run.scenarios)
+            {
+                double sum = 0.0;
+                for (double m : s.micros)
+                    sum += m;
+
+                json.beginObject()
+                    .field("name", s.name)
+                    .field("description", s.description)
+                    .field("blocks", static_cast<int64_t>(s.micros.size()))
+                    .field("meanUs", s.micros.empty() ? 0.0 : sum / static_cast<double>(s.micros.size()))
+                    .field("p50Us", percentile(s.micros, 50.0))
+                    .field("p99Us", percentile(s.micros, 99.0))
+                    .field("p999Us", percentile(s.micros, 99.9))
+                    .field("maxUs", percentile(s.micros, 100.0))
+                    .field("overBudget", s.overBudget);
+
+                json.key("flaggedBlocks").beginArray();
+                for (const auto& f : s.flagged)
+                {
+                    json.beginObject()
+                        .field("block", f.index)
+                        .field("timeSeconds", f.timeSeconds)
+                        .field("us", f.micros)
+                        .field("budgetFraction", f.micros / run.budgetMicros)
+                        .endObject();
+                }
+                json.endArray();
+                json.endObject();
+            }
+            json.endArray();
+            json.endObject();
+        }
+        json.endArray();
+
+        json.field("totalOverBudget", totalOverBudget);
+        json.endObject();
+    });
+
+    if (! written)
+        return 1;
+    return (args.has("--strict") && totalOverBudget > 0) ? 2 : 0;
+}